@@ -0,0 +1,193 @@
+/*
+  Key hash benchmark: throughput and collision rate of the key hash policies in murmurhash.h on the object
+  keys of real documents.
+
+  Build and run from the repository root:
+     g++ -O2 -std=c++11 -I. bench/hashbench.cpp sjson.cpp murmurhash.cpp -o hashbench
+     ./hashbench a.json b.json ...
+
+  Every key of every object in the files is one sample, so keys weigh by how often they occur. Without
+  files a small built in set of documents is used. The "stream" column feeds the key a byte at a time,
+  like the parser does for quoted keys.
+*/
+
+#include "sjson.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <set>
+#include <string>
+#include <vector>
+
+static const char *builtinDocuments[] = {
+   "{\"name\": \"sjson\", \"version\": \"1.0.0\", \"description\": \"json parser\", \"main\": \"sjson.cpp\","
+   " \"scripts\": {\"build\": \"make\", \"test\": \"make test\"}, \"repository\": {\"type\": \"git\", \"url\": \"\"},"
+   " \"keywords\": [\"json\"], \"author\": \"\", \"license\": \"MIT\", \"devDependencies\": {\"gcc\": \"*\"}}",
+
+   "{\"type\": \"FeatureCollection\", \"features\": [{\"type\": \"Feature\", \"id\": 1, \"geometry\": {\"type\": \"Point\","
+   " \"coordinates\": [102.0, 0.5]}, \"properties\": {\"name\": \"a\", \"population\": 100, \"elevation\": 12}},"
+   " {\"type\": \"Feature\", \"id\": 2, \"geometry\": {\"type\": \"LineString\", \"coordinates\": [[102.0, 0.0], [103.0, 1.0]]},"
+   " \"properties\": {\"name\": \"b\", \"population\": 200, \"elevation\": 7}}]}",
+
+   "{\"created_at\": \"Thu Apr 06 15:24:15 +0000 2017\", \"id\": 850006245121695744, \"id_str\": \"850006245121695744\","
+   " \"text\": \"hi\", \"truncated\": false, \"in_reply_to_status_id\": null, \"in_reply_to_user_id\": null,"
+   " \"user\": {\"id\": 6253282, \"id_str\": \"6253282\", \"name\": \"api\", \"screen_name\": \"api\", \"location\": \"\","
+   " \"followers_count\": 6133636, \"friends_count\": 12, \"listed_count\": 12936, \"favourites_count\": 31,"
+   " \"statuses_count\": 3658, \"verified\": true, \"profile_image_url\": \"\", \"default_profile\": false},"
+   " \"retweet_count\": 284, \"favorite_count\": 399, \"entities\": {\"hashtags\": [], \"urls\": [], \"user_mentions\": []},"
+   " \"favorited\": false, \"retweeted\": false, \"lang\": \"en\"}",
+
+   "window = { width = 1920 height = 1080 fullscreen = false vsync = true }\n"
+   "renderer = { shadow_map_size = 2048 msaa = 4 hdr = true bloom_threshold = 1.2 tonemap = \"aces\" }\n"
+   "entities = [ { name = \"player\" position = [0 0 0] rotation = [0 0 0 1] scale = [1 1 1] mesh = \"player.mesh\" }\n"
+   "             { name = \"camera\" position = [0 2 -5] rotation = [0 0 0 1] scale = [1 1 1] fov = 60 near = 0.1 far = 1000 } ]\n",
+};
+
+static void collectKeys(sJSON *item, std::vector<std::string> &keys) {
+   for (sJSON *c = sJSONgetChild(item); c; c = c->next) {
+      if (c->nameString)
+         keys.push_back(c->nameString);
+      collectKeys(c, keys);
+   }
+}
+
+static bool collectDocument(const char *text, const char *source, std::vector<std::string> &keys) {
+   sJSON *root = sJSONparse(text);
+   if (!root) {
+      fprintf(stderr, "%s: parse error near \"%.20s\"\n", source, sJSONgetErrorPtr());
+      return false;
+   }
+   collectKeys(root, keys);
+   sJSONdelete(root);
+   return true;
+}
+
+static char *readFile(const char *path) {
+   FILE *f = fopen(path, "rb");
+   if (!f)
+      return 0;
+   fseek(f, 0, SEEK_END);
+   long size = ftell(f);
+   fseek(f, 0, SEEK_SET);
+   char *text = (char*)malloc(size + 1);
+   if (text && fread(text, 1, size, f) != (size_t)size) {
+      free(text);
+      text = 0;
+   }
+   if (text)
+      text[size] = 0;
+   fclose(f);
+   return text;
+}
+
+struct Corpus {
+   std::vector<char> bytes;         // all samples back to back
+   std::vector<uint32_t> offsets;   // sample i is [offsets[i], offsets[i+1])
+   std::vector<std::string> unique;
+};
+
+static uint64_t sink;   // keeps the hashing from being optimized away
+
+static double seconds(std::chrono::steady_clock::time_point start) {
+   return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template<typename Policy>
+static void run(const char *name, const Corpus &corpus) {
+   const uint8_t *bytes = (const uint8_t*)&corpus.bytes[0];
+   const uint32_t *offsets = &corpus.offsets[0];
+   size_t count = corpus.offsets.size() - 1;
+
+   // one shot and streaming throughput, repeated for at least 0.2s each
+   double hashTime, streamTime;
+   size_t rounds = 0;
+   std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+   do {
+      for (size_t i = 0; i < count; i++)
+         sink += Policy::hash(bytes + offsets[i], offsets[i+1] - offsets[i]);
+      rounds++;
+   } while ((hashTime = seconds(start)) < 0.2);
+   size_t streamRounds = 0;
+   start = std::chrono::steady_clock::now();
+   do {
+      for (size_t i = 0; i < count; i++) {
+         typename Policy::State state;
+         Policy::init(&state);
+         for (uint32_t b = offsets[i]; b < offsets[i+1]; b++)
+            Policy::update(&state, bytes[b]);
+         sink += Policy::finish(&state);
+      }
+      streamRounds++;
+   } while ((streamTime = seconds(start)) < 0.2);
+
+   // collisions among the distinct keys, on the full hash and on the first probe of a half full table
+   std::vector<typename Policy::hash_t> hashes;
+   for (size_t i = 0; i < corpus.unique.size(); i++)
+      hashes.push_back(Policy::hash((const uint8_t*)corpus.unique[i].data(), (uint32_t)corpus.unique[i].size()));
+   uint32_t capacity = 64;
+   while (capacity < hashes.size() * 2)
+      capacity *= 2;
+   std::vector<char> used(capacity, 0);
+   size_t bucketCollisions = 0;
+   for (size_t i = 0; i < hashes.size(); i++) {
+      char &slot = used[(uint32_t)hashes[i] & (capacity - 1)];
+      bucketCollisions += slot;
+      slot = 1;
+   }
+   std::sort(hashes.begin(), hashes.end());
+   size_t collisions = hashes.size() - (std::unique(hashes.begin(), hashes.end()) - hashes.begin());
+
+   double mb = corpus.bytes.size() / 1e6;
+   printf("%-14s %9.2f %9.1f %9.2f %9.1f %10zu %9.2f%%\n", name,
+          hashTime * 1e9 / (rounds * count), mb * rounds / hashTime,
+          streamTime * 1e9 / (streamRounds * count), mb * streamRounds / streamTime,
+          collisions, 100.0 * bucketCollisions / (hashes.size() ? hashes.size() : 1));
+}
+
+int main(int argc, char **argv) {
+   std::vector<std::string> keys;
+   if (argc > 1) {
+      for (int i = 1; i < argc; i++) {
+         char *text = readFile(argv[i]);
+         if (!text) {
+            fprintf(stderr, "%s: cannot read\n", argv[i]);
+            return 1;
+         }
+         collectDocument(text, argv[i], keys);
+         free(text);
+      }
+   } else {
+      for (size_t i = 0; i < sizeof(builtinDocuments) / sizeof(builtinDocuments[0]); i++)
+         collectDocument(builtinDocuments[i], "builtin", keys);
+   }
+   if (keys.empty()) {
+      fprintf(stderr, "no keys found\n");
+      return 1;
+   }
+
+   Corpus corpus;
+   size_t total = 0;
+   for (size_t i = 0; i < keys.size(); i++)
+      total += keys[i].size();
+   corpus.bytes.reserve(total + 1);
+   for (size_t i = 0; i < keys.size(); i++) {
+      corpus.offsets.push_back((uint32_t)corpus.bytes.size());
+      corpus.bytes.insert(corpus.bytes.end(), keys[i].begin(), keys[i].end());
+   }
+   corpus.offsets.push_back((uint32_t)corpus.bytes.size());
+   corpus.bytes.push_back(0);
+   std::set<std::string> unique(keys.begin(), keys.end());
+   corpus.unique.assign(unique.begin(), unique.end());
+
+   printf("%zu keys, %zu distinct, %.1f bytes average\n\n", keys.size(), corpus.unique.size(), (double)total / keys.size());
+   printf("%-14s %9s %9s %9s %9s %10s %10s\n", "hash", "ns/key", "MB/s", "stream", "MB/s", "collisions", "bucket");
+   run<eastl::Murmur3KeyHash>("murmur3", corpus);
+   run<eastl::Murmur3KeyHash64>("murmur3-64", corpus);
+   run<eastl::WyKeyHash<uint32_t> >("wy", corpus);
+   run<eastl::WyKeyHash<uint64_t> >("wy-64", corpus);
+   run<eastl::Crc32cKeyHash>("crc32c", corpus);
+   return sink == 0x5eed;   // practically never, but the compiler can't tell
+}
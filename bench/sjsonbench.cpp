@@ -0,0 +1,325 @@
+/*
+  Parser benchmark: throughput, time and allocations per operation of parse, print, lookup and delete on
+  generated documents, and on files given as arguments.
+
+  Build and run from the repository root:
+     g++ -O2 -std=c++11 -pthread -I. bench/sjsonbench.cpp sjson.cpp murmurhash.cpp -o sjsonbench
+     ./sjsonbench [--csv | --json] [--label name] [--scale n] [--time seconds] [a.json ...]
+
+  The corpora are numbers, strings, nested, wide, dialect and jsonl, built from a fixed seed so runs compare.
+  --scale multiplies their size (1 is about 2MB each). --csv and --json print one record per corpus and
+  operation, tagged with --label (a version or commit), to track regressions. An operation is one whole
+  document for parse, print and delete, and one sJSONgetObjectItem call for lookup.
+*/
+
+#include "sjson.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+static std::atomic<size_t> allocs;    // sJSONparseMany allocates on several threads
+static void *countingMalloc(size_t size) {
+   allocs++;
+   return malloc(size);
+}
+
+static uint32_t seed = 12345;
+static uint32_t random(uint32_t range) {
+   seed = seed * 1664525u + 1013904223u;
+   return (seed >> 8) % range;
+}
+
+static std::string randomWord() {
+   std::string word;
+   for (uint32_t i = 0, n = 3 + random(8); i < n; i++)
+      word += (char)('a' + random(26));
+   return word;
+}
+
+static std::string numbersCorpus(size_t bytes) {
+   std::string text = "{\"vertices\": [";
+   char number[32];
+   while (text.size() < bytes) {
+      for (int i = 0; i < 3; i++) {
+         snprintf(number, sizeof(number), "%.4f, ", (random(2000000) - 1000000) / 1000.0);
+         text += number;
+      }
+      snprintf(number, sizeof(number), "%u, ", random(65536));
+      text += number;
+   }
+   text += "0], \"count\": 1}";
+   return text;
+}
+
+static std::string stringsCorpus(size_t bytes) {
+   static const char *escapes[] = { "\\n", "\\\"", "\\t", "\\u00e9", "\\\\" };
+   std::string text = "[";
+   while (text.size() < bytes) {
+      text += "\"";
+      for (uint32_t i = 0, n = 2 + random(12); i < n; i++) {
+         text += randomWord();
+         text += random(8) ? " " : escapes[random(5)];
+      }
+      text += "\", ";
+   }
+   text += "\"\"]";
+   return text;
+}
+
+static std::string nestedCorpus(size_t bytes) {
+   std::string text = "[";
+   while (text.size() < bytes) {
+      std::string open, close;
+      for (uint32_t depth = 0, n = 50 + random(150); depth < n; depth++) {
+         if (random(2)) {
+            open += "{\"" + randomWord() + "\": ";
+            close = "}" + close;
+         } else {
+            open += "[" + std::to_string(random(100)) + ", ";
+            close = "]" + close;
+         }
+      }
+      text += open + "null" + close + ", ";
+   }
+   text += "null]";
+   return text;
+}
+
+static std::string wideCorpus(size_t bytes) {
+   std::string text = "{";
+   for (uint32_t i = 0; text.size() < bytes; i++)
+      text += "\"" + randomWord() + std::to_string(i) + "\": " + std::to_string(random(1000000)) + ", ";
+   text += "\"last\": true}";
+   return text;
+}
+
+static std::string dialectCorpus(size_t bytes) {
+   std::string text = "// generated config\n";
+   for (uint32_t i = 0; text.size() < bytes; i++) {
+      text += "section" + std::to_string(i) + " = {\n";
+      text += "   /* " + randomWord() + " */\n";
+      text += "   name = \"" + randomWord() + "\"\n";
+      text += "   enabled = " + std::string(random(2) ? "true" : "false") + "\n";
+      text += "   size = [" + std::to_string(random(4096)) + " " + std::to_string(random(4096)) + "]\n";
+      text += "   scale = " + std::to_string(random(100) / 10.0) + "   // " + randomWord() + "\n";
+      text += "}\n";
+   }
+   return text;
+}
+
+static std::string jsonlCorpus(size_t bytes) {
+   std::string text;
+   for (uint32_t i = 0; text.size() < bytes; i++)
+      text += "{\"id\": " + std::to_string(i) + ", \"user\": \"" + randomWord() + "\", \"score\": " +
+              std::to_string(random(10000) / 100.0) + ", \"tags\": [\"" + randomWord() + "\", \"" + randomWord() + "\"]}\n";
+   return text;
+}
+
+static char *readFile(const char *path) {
+   FILE *f = fopen(path, "rb");
+   if (!f)
+      return 0;
+   fseek(f, 0, SEEK_END);
+   long size = ftell(f);
+   fseek(f, 0, SEEK_SET);
+   char *text = (char*)malloc(size + 1);
+   if (text && fread(text, 1, size, f) != (size_t)size) {
+      free(text);
+      text = 0;
+   }
+   if (text)
+      text[size] = 0;
+   fclose(f);
+   return text;
+}
+
+struct Corpus {
+   std::string name;
+   std::string text;
+   bool lines;    // JSON Lines, parsed with sJSONparseMany
+};
+
+struct Result {
+   double seconds;
+   size_t ops;
+   size_t allocs;
+};
+
+static const char *label = "";
+static int format = 0;    // 0 table, 1 csv, 2 json
+static double minTime = 0.2;
+static int records = 0;
+
+static double seconds(std::chrono::steady_clock::time_point start) {
+   return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void report(const Corpus &corpus, const char *op, const Result &r, size_t bytesPerOp) {
+   double ns = r.seconds * 1e9 / r.ops;
+   double mb = bytesPerOp ? bytesPerOp * (double)r.ops / r.seconds / 1e6 : 0;
+   double perOp = (double)r.allocs / r.ops;
+   if (format == 1)
+      printf("%s,%s,%s,%zu,%zu,%.1f,%.2f,%.2f\n", label, corpus.name.c_str(), op, corpus.text.size(), r.ops, ns, mb, perOp);
+   else if (format == 2)
+      printf("%s{\"label\": \"%s\", \"corpus\": \"%s\", \"op\": \"%s\", \"bytes\": %zu, \"ops\": %zu, \"ns_per_op\": %.1f,"
+             " \"mb_per_s\": %.2f, \"allocs_per_op\": %.2f}", records ? ",\n   " : "[\n   ", label, corpus.name.c_str(), op,
+             corpus.text.size(), r.ops, ns, mb, perOp);
+   else
+      printf("%-10s %-16s %14.1f %10.2f %12.2f\n", corpus.name.c_str(), op, ns, mb, perOp);
+   records++;
+}
+
+static int deleteDocument(sJSON *document, void *) {
+   sJSONdelete(document);
+   return 1;
+}
+
+// keys are hashed up front, as a literal key is at compile time
+struct Lookup {
+   Lookup(sJSON *object, const char *key) : object(object), key(key), hash(eastl::FixedMurmurHash(this->key.c_str())) {}
+   Lookup(const Lookup &other) : object(other.object), key(other.key), hash(other.hash.mHash, key.c_str()) {}
+   sJSON *object;
+   std::string key;
+   eastl::FixedMurmurHash hash;
+};
+
+static void collectLookups(sJSON *item, std::vector<Lookup> &lookups) {
+   for (sJSON *c = sJSONgetChild(item); c; c = c->next) {
+      if ((item->type & 255) == sJSON_Object && c->nameString)
+         lookups.push_back(Lookup(item, c->nameString));
+      collectLookups(c, lookups);
+   }
+}
+
+static void run(const Corpus &corpus) {
+   const char *text = corpus.text.c_str();
+   Result r = { 0, 0, 0 };
+   std::chrono::steady_clock::time_point start;
+   if (corpus.lines) {
+      allocs = 0;
+      start = std::chrono::steady_clock::now();
+      do {
+         sJSONparseMany(text, corpus.text.size(), deleteDocument, 0);
+         r.ops++;
+      } while ((r.seconds = seconds(start)) < minTime);
+      r.allocs = allocs;
+      report(corpus, "parseMany", r, corpus.text.size());
+      return;
+   }
+
+   sJSON *tree = sJSONparse(text);
+   if (!tree) {
+      fprintf(stderr, "%s: parse error near \"%.20s\"\n", corpus.name.c_str(), sJSONgetErrorPtr());
+      return;
+   }
+
+   allocs = 0;
+   start = std::chrono::steady_clock::now();
+   do {
+      sJSONdelete(sJSONparse(text));
+      r.ops++;
+   } while ((r.seconds = seconds(start)) < minTime);
+   r.allocs = allocs;
+   Result deletes = { 0, 0, 0 };
+   for (size_t i = 0; i < r.ops || deletes.seconds < minTime; i++) {    // parse and delete, timing the delete alone
+      sJSON *copy = sJSONparse(text);
+      allocs = 0;
+      start = std::chrono::steady_clock::now();
+      sJSONdelete(copy);
+      deletes.seconds += seconds(start);
+      deletes.ops++;
+      deletes.allocs += allocs;
+   }
+   r.seconds -= deletes.seconds * r.ops / deletes.ops;
+   report(corpus, "parse", r, corpus.text.size());
+
+   static const char *printNames[] = { "print", "printUnformatted" };
+   for (int formatted = 1; formatted >= 0; formatted--) {
+      Result p = { 0, 0, 0 };
+      allocs = 0;
+      start = std::chrono::steady_clock::now();
+      do {
+         free(formatted ? sJSONprint(tree) : sJSONprintUnformatted(tree));
+         p.ops++;
+      } while ((p.seconds = seconds(start)) < minTime);
+      p.allocs = allocs;
+      report(corpus, printNames[1 - formatted], p, corpus.text.size());
+   }
+
+   std::vector<Lookup> lookups;
+   collectLookups(tree, lookups);
+   if (!lookups.empty()) {
+      Result l = { 0, 0, 0 };
+      size_t found = 0;
+      allocs = 0;
+      start = std::chrono::steady_clock::now();
+      do {
+         for (size_t i = 0; i < lookups.size(); i++)
+            found += sJSONgetObjectItem(lookups[i].object, lookups[i].hash) != 0;
+         l.ops += lookups.size();
+      } while ((l.seconds = seconds(start)) < minTime);
+      l.allocs = allocs;
+      if (found != l.ops)
+         fprintf(stderr, "%s: %zu lookups missed\n", corpus.name.c_str(), l.ops - found);
+      report(corpus, "lookup", l, 0);
+   }
+
+   report(corpus, "delete", deletes, corpus.text.size());
+   sJSONdelete(tree);
+}
+
+int main(int argc, char **argv) {
+   double scale = 1;
+   std::vector<Corpus> corpora;
+   for (int i = 1; i < argc; i++) {
+      if (!strcmp(argv[i], "--csv"))
+         format = 1;
+      else if (!strcmp(argv[i], "--json"))
+         format = 2;
+      else if (!strcmp(argv[i], "--label") && i + 1 < argc)
+         label = argv[++i];
+      else if (!strcmp(argv[i], "--scale") && i + 1 < argc)
+         scale = atof(argv[++i]);
+      else if (!strcmp(argv[i], "--time") && i + 1 < argc)
+         minTime = atof(argv[++i]);
+      else {
+         char *text = readFile(argv[i]);
+         if (!text) {
+            fprintf(stderr, "%s: cannot read\n", argv[i]);
+            return 1;
+         }
+         Corpus file = { argv[i], text, false };
+         corpora.push_back(file);
+         free(text);
+      }
+   }
+
+   size_t bytes = (size_t)(2000000 * scale);
+   Corpus generated[] = {
+      { "numbers", numbersCorpus(bytes), false },
+      { "strings", stringsCorpus(bytes), false },
+      { "nested", nestedCorpus(bytes), false },
+      { "wide", wideCorpus(bytes), false },
+      { "dialect", dialectCorpus(bytes), false },
+      { "jsonl", jsonlCorpus(bytes * 4), true },
+   };
+   corpora.insert(corpora.begin(), generated, generated + sizeof(generated) / sizeof(generated[0]));
+
+   sJSON_Hooks hooks = { countingMalloc, free };
+   sJSONinitHooks(&hooks);
+
+   if (format == 1)
+      printf("label,corpus,op,bytes,ops,ns_per_op,mb_per_s,allocs_per_op\n");
+   else if (format == 0)
+      printf("%-10s %-16s %14s %10s %12s\n", "corpus", "op", "ns/op", "MB/s", "allocs/op");
+   for (size_t i = 0; i < corpora.size(); i++)
+      run(corpora[i]);
+   if (format == 2)
+      printf("%s]\n", records ? "\n" : "[");
+   return 0;
+}
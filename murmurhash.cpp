@@ -1,6 +1,18 @@
 
 #include "murmurhash.h"
 
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+   #define EASTL_CRC32C_SSE42
+   #if defined(__x86_64__) || defined(_M_X64)   // the batch hash gathers through 64bit key pointers
+      #define EASTL_MURMUR_AVX2
+   #endif
+   #include <nmmintrin.h>
+   #include <immintrin.h>
+   #ifdef _MSC_VER
+      #include <intrin.h>
+   #endif
+#endif
+
 // this is the MurmurHash 3 (based on r136)
 // http://code.google.com/p/smhasher/
 
@@ -95,6 +107,35 @@ uint32_t eastl::murmurHash( const uint8_t *data, uint32_t len) {
    return h1;
 }
 
+void eastl::murmurHashUpdate(MurmurHashState *state, const uint8_t *data, uint32_t len) {
+   uint32_t c1 = 0xcc9e2d51;
+   uint32_t c2 = 0x1b873593;
+
+   // finish a block left over from the last update
+   while (len && (state->len & 3)) {
+      murmurHashUpdate(state, *data++);
+      len--;
+   }
+
+   const int nblocks = len / 4;
+   uint32_t h1 = state->h1;
+   for(int i = 0; i < nblocks; i++) {
+      uint32_t k1;
+      memcpy(&k1, data + i*4, 4);
+      k1 *= c1;
+      k1 = ROTL32(k1,15);
+      k1 *= c2;
+      h1 ^= k1;
+      h1 = ROTL32(h1,13);
+      h1 = h1*5+0xe6546b64;
+   }
+   state->h1 = h1;
+   state->len += nblocks*4;
+
+   for(uint32_t i = nblocks*4; i < len; i++)
+      murmurHashUpdate(state, data[i]);
+}
+
 void eastl::murmurHash_x86_128( const uint8_t *data, uint32_t len, void *out) {
    const uint32_t seed = 0;
    const int nblocks = len / 16;
@@ -283,3 +324,263 @@ void eastl::murmurHash_x64_128( const uint8_t *data, uint32_t len, void *out) {
    ((uint64_t*)out)[0] = h1;
    ((uint64_t*)out)[1] = h2;
  }
+
+uint64_t eastl::murmurHash64( const uint8_t *data, uint32_t len) {
+   uint64_t out[2];
+   murmurHash_x64_128(data, len, out);
+   return out[0];
+}
+
+void eastl::murmurHash64Update(MurmurHash64State *state, const uint8_t *data, uint32_t len) {
+   // finish a block left over from the last update
+   while (len && (state->len & 15)) {
+      murmurHash64Update(state, *data++);
+      len--;
+   }
+
+   const int nblocks = len / 16;
+   for(int i = 0; i < nblocks; i++)
+      murmurHash64Block(state, data + i*16);
+   state->len += nblocks*16;
+
+   for(uint32_t i = nblocks*16; i < len; i++)
+      murmurHash64Update(state, data[i]);
+}
+
+uint64_t eastl::wyHash( const uint8_t *data, uint32_t len) {
+   uint64_t h = wySecret0;
+   const int nwords = len / 8;
+   const uint64_t * words = (const uint64_t *)(data);
+   for(int i = 0; i < nwords; i++)
+      h = wyMum(getblock(words,i) ^ wySecret1, h ^ wySecret2);
+
+   const uint8_t * tail = (const uint8_t*)(data + nwords*8);
+   uint64_t k = 0;
+   switch(len & 7) {
+   case 7: k ^= uint64_t(tail[6]) << 48;	/* fall through */
+   case 6: k ^= uint64_t(tail[5]) << 40;	/* fall through */
+   case 5: k ^= uint64_t(tail[4]) << 32;	/* fall through */
+   case 4: k ^= uint64_t(tail[3]) << 24;	/* fall through */
+   case 3: k ^= uint64_t(tail[2]) << 16;	/* fall through */
+   case 2: k ^= uint64_t(tail[1]) << 8;	/* fall through */
+   case 1: k ^= uint64_t(tail[0]);
+           h = wyMum(k ^ wySecret1, h ^ wySecret2);
+   };
+   return wyMum(h ^ wySecret1, len ^ wySecret2);
+}
+
+void eastl::wyHashUpdate(WyHashState *state, const uint8_t *data, uint32_t len) {
+   // finish a word left over from the last update
+   while (len && (state->len & 7)) {
+      wyHashUpdate(state, *data++);
+      len--;
+   }
+
+   const int nwords = len / 8;
+   uint64_t h = state->h;
+   for(int i = 0; i < nwords; i++)
+      h = wyMum(murmurLoad64(data + i*8) ^ wySecret1, h ^ wySecret2);
+   state->h = h;
+   state->len += nwords*8;
+
+   for(uint32_t i = nwords*8; i < len; i++)
+      wyHashUpdate(state, data[i]);
+}
+
+const uint32_t eastl::crc32cTable[256] = {
+   0x00000000, 0xf26b8303, 0xe13b70f7, 0x1350f3f4, 0xc79a971f, 0x35f1141c, 0x26a1e7e8, 0xd4ca64eb,
+   0x8ad958cf, 0x78b2dbcc, 0x6be22838, 0x9989ab3b, 0x4d43cfd0, 0xbf284cd3, 0xac78bf27, 0x5e133c24,
+   0x105ec76f, 0xe235446c, 0xf165b798, 0x030e349b, 0xd7c45070, 0x25afd373, 0x36ff2087, 0xc494a384,
+   0x9a879fa0, 0x68ec1ca3, 0x7bbcef57, 0x89d76c54, 0x5d1d08bf, 0xaf768bbc, 0xbc267848, 0x4e4dfb4b,
+   0x20bd8ede, 0xd2d60ddd, 0xc186fe29, 0x33ed7d2a, 0xe72719c1, 0x154c9ac2, 0x061c6936, 0xf477ea35,
+   0xaa64d611, 0x580f5512, 0x4b5fa6e6, 0xb93425e5, 0x6dfe410e, 0x9f95c20d, 0x8cc531f9, 0x7eaeb2fa,
+   0x30e349b1, 0xc288cab2, 0xd1d83946, 0x23b3ba45, 0xf779deae, 0x05125dad, 0x1642ae59, 0xe4292d5a,
+   0xba3a117e, 0x4851927d, 0x5b016189, 0xa96ae28a, 0x7da08661, 0x8fcb0562, 0x9c9bf696, 0x6ef07595,
+   0x417b1dbc, 0xb3109ebf, 0xa0406d4b, 0x522bee48, 0x86e18aa3, 0x748a09a0, 0x67dafa54, 0x95b17957,
+   0xcba24573, 0x39c9c670, 0x2a993584, 0xd8f2b687, 0x0c38d26c, 0xfe53516f, 0xed03a29b, 0x1f682198,
+   0x5125dad3, 0xa34e59d0, 0xb01eaa24, 0x42752927, 0x96bf4dcc, 0x64d4cecf, 0x77843d3b, 0x85efbe38,
+   0xdbfc821c, 0x2997011f, 0x3ac7f2eb, 0xc8ac71e8, 0x1c661503, 0xee0d9600, 0xfd5d65f4, 0x0f36e6f7,
+   0x61c69362, 0x93ad1061, 0x80fde395, 0x72966096, 0xa65c047d, 0x5437877e, 0x4767748a, 0xb50cf789,
+   0xeb1fcbad, 0x197448ae, 0x0a24bb5a, 0xf84f3859, 0x2c855cb2, 0xdeeedfb1, 0xcdbe2c45, 0x3fd5af46,
+   0x7198540d, 0x83f3d70e, 0x90a324fa, 0x62c8a7f9, 0xb602c312, 0x44694011, 0x5739b3e5, 0xa55230e6,
+   0xfb410cc2, 0x092a8fc1, 0x1a7a7c35, 0xe811ff36, 0x3cdb9bdd, 0xceb018de, 0xdde0eb2a, 0x2f8b6829,
+   0x82f63b78, 0x709db87b, 0x63cd4b8f, 0x91a6c88c, 0x456cac67, 0xb7072f64, 0xa457dc90, 0x563c5f93,
+   0x082f63b7, 0xfa44e0b4, 0xe9141340, 0x1b7f9043, 0xcfb5f4a8, 0x3dde77ab, 0x2e8e845f, 0xdce5075c,
+   0x92a8fc17, 0x60c37f14, 0x73938ce0, 0x81f80fe3, 0x55326b08, 0xa759e80b, 0xb4091bff, 0x466298fc,
+   0x1871a4d8, 0xea1a27db, 0xf94ad42f, 0x0b21572c, 0xdfeb33c7, 0x2d80b0c4, 0x3ed04330, 0xccbbc033,
+   0xa24bb5a6, 0x502036a5, 0x4370c551, 0xb11b4652, 0x65d122b9, 0x97baa1ba, 0x84ea524e, 0x7681d14d,
+   0x2892ed69, 0xdaf96e6a, 0xc9a99d9e, 0x3bc21e9d, 0xef087a76, 0x1d63f975, 0x0e330a81, 0xfc588982,
+   0xb21572c9, 0x407ef1ca, 0x532e023e, 0xa145813d, 0x758fe5d6, 0x87e466d5, 0x94b49521, 0x66df1622,
+   0x38cc2a06, 0xcaa7a905, 0xd9f75af1, 0x2b9cd9f2, 0xff56bd19, 0x0d3d3e1a, 0x1e6dcdee, 0xec064eed,
+   0xc38d26c4, 0x31e6a5c7, 0x22b65633, 0xd0ddd530, 0x0417b1db, 0xf67c32d8, 0xe52cc12c, 0x1747422f,
+   0x49547e0b, 0xbb3ffd08, 0xa86f0efc, 0x5a048dff, 0x8ecee914, 0x7ca56a17, 0x6ff599e3, 0x9d9e1ae0,
+   0xd3d3e1ab, 0x21b862a8, 0x32e8915c, 0xc083125f, 0x144976b4, 0xe622f5b7, 0xf5720643, 0x07198540,
+   0x590ab964, 0xab613a67, 0xb831c993, 0x4a5a4a90, 0x9e902e7b, 0x6cfbad78, 0x7fab5e8c, 0x8dc0dd8f,
+   0xe330a81a, 0x115b2b19, 0x020bd8ed, 0xf0605bee, 0x24aa3f05, 0xd6c1bc06, 0xc5914ff2, 0x37faccf1,
+   0x69e9f0d5, 0x9b8273d6, 0x88d28022, 0x7ab90321, 0xae7367ca, 0x5c18e4c9, 0x4f48173d, 0xbd23943e,
+   0xf36e6f75, 0x0105ec76, 0x12551f82, 0xe03e9c81, 0x34f4f86a, 0xc69f7b69, 0xd5cf889d, 0x27a40b9e,
+   0x79b737ba, 0x8bdcb4b9, 0x988c474d, 0x6ae7c44e, 0xbe2da0a5, 0x4c4623a6, 0x5f16d052, 0xad7d5351
+};
+
+static uint32_t crc32cSoftware(uint32_t crc, const uint8_t *data, uint32_t len) {
+   for(uint32_t i = 0; i < len; i++)
+      crc = eastl::crc32cTable[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+   return crc;
+}
+
+#ifdef EASTL_CRC32C_SSE42
+#ifndef _MSC_VER
+__attribute__((target("sse4.2")))
+#endif
+static uint32_t crc32cHardware(uint32_t crc, const uint8_t *data, uint32_t len) {
+#if defined(__x86_64__) || defined(_M_X64)
+   uint64_t crc64 = crc;
+   for(; len >= 8; data += 8, len -= 8) {
+      uint64_t k;
+      memcpy(&k, data, 8);
+      crc64 = _mm_crc32_u64(crc64, k);
+   }
+   crc = (uint32_t)crc64;
+#endif
+   for(; len >= 4; data += 4, len -= 4) {
+      uint32_t k;
+      memcpy(&k, data, 4);
+      crc = _mm_crc32_u32(crc, k);
+   }
+   for(; len; data++, len--)
+      crc = _mm_crc32_u8(crc, *data);
+   return crc;
+}
+
+static bool cpuHasSSE42() {
+#ifdef _MSC_VER
+   int info[4];
+   __cpuid(info, 1);
+   return (info[2] & (1 << 20)) != 0;
+#else
+   return __builtin_cpu_supports("sse4.2");
+#endif
+}
+#endif
+
+uint32_t eastl::crc32cUpdate(uint32_t crc, const uint8_t *data, uint32_t len) {
+#ifdef EASTL_CRC32C_SSE42
+   static const bool hardware = cpuHasSSE42();
+   if (hardware)
+      return crc32cHardware(crc, data, len);
+#endif
+   return crc32cSoftware(crc, data, len);
+}
+
+#ifdef EASTL_MURMUR_AVX2
+#ifndef _MSC_VER
+__attribute__((target("avx2")))
+#endif
+static inline __m256i rotl32x8(__m256i x, int r) {
+   return _mm256_or_si256(_mm256_slli_epi32(x, r), _mm256_srli_epi32(x, 32 - r));
+}
+
+// murmurHash of 8 keys, one per 32bit lane. Lanes run the same rounds; a lane whose key has run out of blocks
+// keeps its h1, and the tails and lengths are mixed in for all lanes at the end.
+#ifndef _MSC_VER
+__attribute__((target("avx2")))
+#endif
+static void murmurHash8(const char **keys, const uint32_t *lens, uint32_t *out) {
+   const __m256i c1 = _mm256_set1_epi32((int)0xcc9e2d51);
+   const __m256i c2 = _mm256_set1_epi32(0x1b873593);
+   const __m256i m1 = _mm256_set1_epi32((int)0x85ebca6b);
+   const __m256i m2 = _mm256_set1_epi32((int)0xc2b2ae35);
+   alignas(32) uint32_t k[8];
+   uint32_t maxBlocks = 0;
+   for(int i = 0; i < 8; i++)
+      if (lens[i] / 4 > maxBlocks)
+         maxBlocks = lens[i] / 4;
+
+   // blocks are gathered straight from the key pointers, masked so a lane never reads past its key
+   const __m256i len = _mm256_loadu_si256((const __m256i*)lens);
+   const __m256i nblocks = _mm256_srli_epi32(len, 2);
+   __m256i addrLo = _mm256_loadu_si256((const __m256i*)keys);
+   __m256i addrHi = _mm256_loadu_si256((const __m256i*)(keys + 4));
+   const __m256i step = _mm256_set1_epi64x(4);
+   __m256i h1 = _mm256_setzero_si256();
+   for(uint32_t b = 0; b < maxBlocks; b++) {
+      __m256i active = _mm256_cmpgt_epi32(nblocks, _mm256_set1_epi32((int)b));
+      __m128i kLo = _mm256_mask_i64gather_epi32(_mm_setzero_si128(), (const int*)0, addrLo, _mm256_castsi256_si128(active), 1);
+      __m128i kHi = _mm256_mask_i64gather_epi32(_mm_setzero_si128(), (const int*)0, addrHi, _mm256_extracti128_si256(active, 1), 1);
+      addrLo = _mm256_add_epi64(addrLo, step);
+      addrHi = _mm256_add_epi64(addrHi, step);
+      __m256i k1 = _mm256_inserti128_si256(_mm256_castsi128_si256(kLo), kHi, 1);
+      k1 = _mm256_mullo_epi32(k1, c1);
+      k1 = rotl32x8(k1, 15);
+      k1 = _mm256_mullo_epi32(k1, c2);
+      __m256i h = _mm256_xor_si256(h1, k1);
+      h = rotl32x8(h, 13);
+      h = _mm256_add_epi32(_mm256_add_epi32(_mm256_slli_epi32(h, 2), h), _mm256_set1_epi32((int)0xe6546b64));
+      h1 = _mm256_blendv_epi8(h1, h, active);
+   }
+
+   // the tail is the top len&3 bytes of the key's last 4, which a lane can read in bounds once len >= 4
+   const __m256i lenLo = _mm256_cvtepu32_epi64(_mm256_castsi256_si128(len));
+   const __m256i lenHi = _mm256_cvtepu32_epi64(_mm256_extracti128_si256(len, 1));
+   const __m256i four = _mm256_set1_epi64x(4);
+   __m256i wide = _mm256_cmpgt_epi32(len, _mm256_set1_epi32(3));
+   __m128i wLo = _mm256_mask_i64gather_epi32(_mm_setzero_si128(), (const int*)0,
+                                             _mm256_sub_epi64(_mm256_add_epi64(_mm256_loadu_si256((const __m256i*)keys), lenLo), four),
+                                             _mm256_castsi256_si128(wide), 1);
+   __m128i wHi = _mm256_mask_i64gather_epi32(_mm_setzero_si128(), (const int*)0,
+                                             _mm256_sub_epi64(_mm256_add_epi64(_mm256_loadu_si256((const __m256i*)(keys + 4)), lenHi), four),
+                                             _mm256_extracti128_si256(wide, 1), 1);
+   __m256i shift = _mm256_slli_epi32(_mm256_sub_epi32(_mm256_set1_epi32(4), _mm256_and_si256(len, _mm256_set1_epi32(3))), 3);
+   __m256i k1 = _mm256_srlv_epi32(_mm256_inserti128_si256(_mm256_castsi128_si256(wLo), wHi, 1), shift);   // shift 32 gives 0
+   if (_mm256_movemask_ps(_mm256_castsi256_ps(wide)) != 0xff) {
+      _mm256_store_si256((__m256i*)k, k1);
+      for(int i = 0; i < 8; i++) {
+         const uint8_t * tail = (const uint8_t*)keys[i];
+         switch(lens[i]) {
+         case 3: k[i] = tail[0] | (tail[1] << 8) | (tail[2] << 16); break;
+         case 2: k[i] = tail[0] | (tail[1] << 8); break;
+         case 1: k[i] = tail[0]; break;
+         case 0: k[i] = 0; break;
+         };
+      }
+      k1 = _mm256_load_si256((const __m256i*)k);
+   }
+   k1 = _mm256_mullo_epi32(k1, c1);   // an empty tail mixes to zero
+   k1 = rotl32x8(k1, 15);
+   k1 = _mm256_mullo_epi32(k1, c2);
+   h1 = _mm256_xor_si256(h1, k1);
+
+   h1 = _mm256_xor_si256(h1, len);
+   h1 = _mm256_xor_si256(h1, _mm256_srli_epi32(h1, 16));
+   h1 = _mm256_mullo_epi32(h1, m1);
+   h1 = _mm256_xor_si256(h1, _mm256_srli_epi32(h1, 13));
+   h1 = _mm256_mullo_epi32(h1, m2);
+   h1 = _mm256_xor_si256(h1, _mm256_srli_epi32(h1, 16));
+   _mm256_storeu_si256((__m256i*)out, h1);
+}
+
+static bool cpuHasAVX2() {
+#ifdef _MSC_VER
+   int info[4];
+   __cpuid(info, 1);
+   if (!(info[2] & (1 << 27)) || (_xgetbv(0) & 6) != 6)   // OSXSAVE, and the OS saves the ymm registers
+      return false;
+   __cpuidex(info, 7, 0);
+   return (info[1] & (1 << 5)) != 0;
+#else
+   return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+void eastl::murmurHashBatch(const char **keys, const uint32_t *lens, uint32_t *out, uint32_t n) {
+   uint32_t i = 0;
+#ifdef EASTL_MURMUR_AVX2
+   static const bool avx2 = cpuHasAVX2();
+   if (avx2)
+      for(; i + 8 <= n; i += 8)
+         murmurHash8(keys + i, lens + i, out + i);
+#endif
+   for(; i < n; i++)
+      out[i] = murmurHash((const uint8_t*)keys[i], lens[i]);
+}
@@ -19,12 +19,19 @@ namespace eastl {
 
 uint32_t murmurHash(const uint8_t *data, uint32_t len);
 
+// out[i] = murmurHash(keys[i], lens[i]) for n keys. Hashes 8 keys at a time with AVX2 when the cpu has it,
+// which pays off for many short keys, like building an index or a key table.
+void murmurHashBatch(const char **keys, const uint32_t *lens, uint32_t *out, uint32_t n);
+
 //128bit hash function for 32bit systems
 void murmurHash_x86_128( const uint8_t *data, uint32_t len, void *out);
 
 //128bit hash function for 64bit systems
 void murmurHash_x64_128( const uint8_t *data, uint32_t len, void *out);
 
+//64bit hash, the first half of murmurHash_x64_128
+uint64_t murmurHash64(const uint8_t *data, uint32_t len);
+
 //on 64bit systems cityhash is reported to be much faster for 64bit hash values!
 
 inline uint32_t murmurString(const char *buffer) {
@@ -32,45 +39,359 @@ inline uint32_t murmurString(const char *buffer) {
    return murmurHash((uint8_t*)buffer, len);
 }
 
-#ifdef _MSC_VER
-   #define FORCE_INLINE    __forceinline
-   #define ROTL32(x,y)     _rotl(x,y)
-   #define ROTL64(x,y)     _rotl64(x,y)
-#else
-   #define FORCE_INLINE __attribute__((always_inline))
+// Compile time murmurHash for string literals. Written as single expression recursions so it is valid
+// C++11 constexpr; it matches murmurHash byte for byte.
+constexpr uint32_t murmurRotl32(uint32_t x, int r) {
+   return (x << r) | (x >> (32 - r));
+}
+constexpr uint32_t murmurByte(const char *s, uint32_t i) {
+   return (uint32_t)(uint8_t)s[i];
+}
+constexpr uint32_t murmurBlockConst(const char *s, uint32_t i) {
+   return murmurByte(s, i) | (murmurByte(s, i+1) << 8) | (murmurByte(s, i+2) << 16) | (murmurByte(s, i+3) << 24);
+}
+constexpr uint32_t murmurTailConst(const char *s, uint32_t n) {
+   return n == 3 ? murmurByte(s, 0) | (murmurByte(s, 1) << 8) | (murmurByte(s, 2) << 16)
+        : n == 2 ? murmurByte(s, 0) | (murmurByte(s, 1) << 8)
+        : murmurByte(s, 0);
+}
+constexpr uint32_t murmurMixKConst(uint32_t k1) {
+   return murmurRotl32(k1 * 0xcc9e2d51u, 15) * 0x1b873593u;
+}
+constexpr uint32_t murmurBodyConst(const char *s, uint32_t nblocks, uint32_t i, uint32_t h1) {
+   return i == nblocks ? h1
+        : murmurBodyConst(s, nblocks, i + 1, murmurRotl32(h1 ^ murmurMixKConst(murmurBlockConst(s, i * 4)), 13) * 5 + 0xe6546b64u);
+}
+constexpr uint32_t murmurFmix3Const(uint32_t h) { return h ^ (h >> 16); }
+constexpr uint32_t murmurFmix2Const(uint32_t h) { return murmurFmix3Const((h ^ (h >> 13)) * 0xc2b2ae35u); }
+constexpr uint32_t murmurFmixConst(uint32_t h) { return murmurFmix2Const((h ^ (h >> 16)) * 0x85ebca6bu); }
 
-   uint32_t inline rotl32 ( uint32_t x, int8_t r ) {
-      return (x << r) | (x >> (32 - r));
+constexpr uint32_t murmurHashConst(const char *s, uint32_t len) {
+   return murmurFmixConst(( (len & 3) ? murmurBodyConst(s, len / 4, 0, 0) ^ murmurMixKConst(murmurTailConst(s + (len & ~3u), len & 3))
+                                      : murmurBodyConst(s, len / 4, 0, 0) ) ^ len);
+}
+
+// Incremental murmurHash: feed the data in any number of pieces, down to single bytes, and get the same
+// value as murmurHash over all of it. Lets a tokenizer hash while it copies, or hash keys split across chunks.
+struct MurmurHashState {
+   uint32_t h1;
+   uint32_t tail;    // bytes of the current, incomplete block
+   uint32_t len;
+};
+
+inline void murmurHashInit(MurmurHashState *state) {
+   state->h1 = 0;
+   state->tail = 0;
+   state->len = 0;
+}
+
+inline void murmurHashUpdate(MurmurHashState *state, uint8_t byte) {
+   state->tail |= (uint32_t)byte << ((state->len & 3) * 8);
+   if ((++state->len & 3) == 0) {
+      state->h1 = murmurRotl32(state->h1 ^ murmurMixKConst(state->tail), 13) * 5 + 0xe6546b64u;
+      state->tail = 0;
    }
-   uint64_t inline rotl64 ( uint64_t x, int8_t r ) {
-     return (x << r) | (x >> (64 - r));
+}
+
+void murmurHashUpdate(MurmurHashState *state, const uint8_t *data, uint32_t len);
+
+inline uint32_t murmurHashFinal(const MurmurHashState *state) {
+   uint32_t h1 = state->h1;
+   if (state->len & 3)
+      h1 ^= murmurMixKConst(state->tail);
+   return murmurFmixConst(h1 ^ state->len);
+}
+
+// Compile time murmurHash64, the same recursions over 16 byte blocks with the two 64bit lanes carried in a pair.
+struct MurmurHash64Pair {
+   uint64_t h1, h2;
+   constexpr MurmurHash64Pair(uint64_t a, uint64_t b) : h1(a), h2(b) {}
+};
+constexpr uint64_t murmurRotl64(uint64_t x, int r) {
+   return (x << r) | (x >> (64 - r));
+}
+constexpr uint64_t murmurBytes64Const(const char *s, uint32_t n) {  //n <= 8 bytes, little endian
+   return n == 0 ? 0 : (uint64_t)(uint8_t)s[0] | (murmurBytes64Const(s + 1, n - 1) << 8);
+}
+constexpr uint64_t murmurMixK1Const64(uint64_t k1) {
+   return murmurRotl64(k1 * 0x87c37b91114253d5ull, 31) * 0x4cf5ad432745937full;
+}
+constexpr uint64_t murmurMixK2Const64(uint64_t k2) {
+   return murmurRotl64(k2 * 0x4cf5ad432745937full, 33) * 0x87c37b91114253d5ull;
+}
+constexpr MurmurHash64Pair murmurBlock64Lane2(uint64_t h1, uint64_t h2, uint64_t k2) {
+   return MurmurHash64Pair(h1, (murmurRotl64(h2 ^ murmurMixK2Const64(k2), 31) + h1) * 5 + 0x38495ab5);
+}
+constexpr MurmurHash64Pair murmurBlock64Const(MurmurHash64Pair h, uint64_t k1, uint64_t k2) {
+   return murmurBlock64Lane2((murmurRotl64(h.h1 ^ murmurMixK1Const64(k1), 27) + h.h2) * 5 + 0x52dce729, h.h2, k2);
+}
+constexpr MurmurHash64Pair murmurBody64Const(const char *s, uint32_t nblocks, uint32_t i, MurmurHash64Pair h) {
+   return i == nblocks ? h
+        : murmurBody64Const(s, nblocks, i + 1, murmurBlock64Const(h, murmurBytes64Const(s + i * 16, 8), murmurBytes64Const(s + i * 16 + 8, 8)));
+}
+constexpr uint64_t murmurFmix64c3Const(uint64_t k) { return k ^ (k >> 33); }
+constexpr uint64_t murmurFmix64c2Const(uint64_t k) { return murmurFmix64c3Const((k ^ (k >> 33)) * 0xc4ceb9fe1a85ec53ull); }
+constexpr uint64_t murmurFmix64Const(uint64_t k) { return murmurFmix64c2Const((k ^ (k >> 33)) * 0xff51afd7ed558ccdull); }
+constexpr uint64_t murmurFinal64Const(uint64_t h1, uint64_t h2) {  //h1 and h2 already include the length
+   return murmurFmix64Const(h1 + h2) + murmurFmix64Const(h2 + h1 + h2);
+}
+constexpr uint64_t murmurTail64Const(MurmurHash64Pair h, const char *tail, uint32_t n, uint32_t len) {  //a zero k mixes to zero
+   return murmurFinal64Const((h.h1 ^ murmurMixK1Const64(murmurBytes64Const(tail, n < 8 ? n : 8))) ^ len,
+                             (h.h2 ^ murmurMixK2Const64(n > 8 ? murmurBytes64Const(tail + 8, n - 8) : 0)) ^ len);
+}
+constexpr uint64_t murmurHash64Const(const char *s, uint32_t len) {
+   return murmurTail64Const(murmurBody64Const(s, len / 16, 0, MurmurHash64Pair(0, 0)), s + (len & ~15u), len & 15, len);
+}
+
+// Incremental murmurHash64, as MurmurHashState is for murmurHash.
+struct MurmurHash64State {
+   uint64_t h1, h2;
+   uint8_t tail[16];  // bytes of the current, incomplete block
+   uint32_t len;
+};
+
+inline void murmurHash64Init(MurmurHash64State *state) {
+   state->h1 = 0;
+   state->h2 = 0;
+   state->len = 0;
+}
+
+inline uint64_t murmurLoad64(const uint8_t *p) {
+   uint64_t k = 0;
+   for (int i = 7; i >= 0; i--)
+      k = (k << 8) | p[i];
+   return k;
+}
+
+inline void murmurHash64Block(MurmurHash64State *state, const uint8_t *block) {
+   MurmurHash64Pair h = murmurBlock64Const(MurmurHash64Pair(state->h1, state->h2), murmurLoad64(block), murmurLoad64(block + 8));
+   state->h1 = h.h1;
+   state->h2 = h.h2;
+}
+
+inline void murmurHash64Update(MurmurHash64State *state, uint8_t byte) {
+   state->tail[state->len & 15] = byte;
+   if ((++state->len & 15) == 0)
+      murmurHash64Block(state, state->tail);
+}
+
+void murmurHash64Update(MurmurHash64State *state, const uint8_t *data, uint32_t len);
+
+inline uint64_t murmurHash64Final(const MurmurHash64State *state) {
+   uint32_t n = state->len & 15;
+   uint8_t tail[16] = {0};
+   memcpy(tail, state->tail, n);
+   return murmurFinal64Const((state->h1 ^ murmurMixK1Const64(murmurLoad64(tail))) ^ state->len,
+                             (state->h2 ^ murmurMixK2Const64(murmurLoad64(tail + 8))) ^ state->len);
+}
+
+// wyKeyHash: a wyhash style hash for short keys. Each 8 byte word costs one 64x64->128 multiply folded to
+// 64 bits, so a key of up to 8 bytes takes two multiplies and no setup. Not bit compatible with wyhash.
+const uint64_t wySecret0 = 0xa0761d6478bd642full;
+const uint64_t wySecret1 = 0xe7037ed1a0b428dbull;
+const uint64_t wySecret2 = 0x8ebc6af09c88c6e3ull;
+
+constexpr uint64_t wyMulHiConst(uint64_t p00, uint64_t p01, uint64_t p10, uint64_t p11) {
+   return p11 + (p01 >> 32) + (p10 >> 32) + (((p00 >> 32) + (p01 & 0xffffffffu) + (p10 & 0xffffffffu)) >> 32);
+}
+constexpr uint64_t wyMumConst(uint64_t a, uint64_t b) {  //low ^ high half of the 128bit product
+   return (a * b) ^ wyMulHiConst((a & 0xffffffffu) * (b & 0xffffffffu), (a & 0xffffffffu) * (b >> 32),
+                                 (a >> 32) * (b & 0xffffffffu), (a >> 32) * (b >> 32));
+}
+inline uint64_t wyMum(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+   __uint128_t r = (__uint128_t)a * b;
+   return (uint64_t)r ^ (uint64_t)(r >> 64);
+#else
+   return wyMumConst(a, b);
+#endif
+}
+constexpr uint64_t wyWordConst(uint64_t h, uint64_t w) {
+   return wyMumConst(w ^ wySecret1, h ^ wySecret2);
+}
+constexpr uint64_t wyBodyConst(const char *s, uint32_t nwords, uint32_t i, uint64_t h) {
+   return i == nwords ? h : wyBodyConst(s, nwords, i + 1, wyWordConst(h, murmurBytes64Const(s + i * 8, 8)));
+}
+constexpr uint64_t wyFinalConst(uint64_t h, uint32_t len) {
+   return wyMumConst(h ^ wySecret1, len ^ wySecret2);
+}
+constexpr uint64_t wyHashConst(const char *s, uint32_t len) {
+   return wyFinalConst((len & 7) ? wyWordConst(wyBodyConst(s, len / 8, 0, wySecret0), murmurBytes64Const(s + (len & ~7u), len & 7))
+                                 : wyBodyConst(s, len / 8, 0, wySecret0), len);
+}
+
+uint64_t wyHash(const uint8_t *data, uint32_t len);
+
+struct WyHashState {
+   uint64_t h;
+   uint64_t tail;    // bytes of the current, incomplete word
+   uint32_t len;
+};
+
+inline void wyHashInit(WyHashState *state) {
+   state->h = wySecret0;
+   state->tail = 0;
+   state->len = 0;
+}
+
+inline void wyHashUpdate(WyHashState *state, uint8_t byte) {
+   state->tail |= (uint64_t)byte << ((state->len & 7) * 8);
+   if ((++state->len & 7) == 0) {
+      state->h = wyMum(state->tail ^ wySecret1, state->h ^ wySecret2);
+      state->tail = 0;
    }
-   #define ROTL32(x,y)     rotl32(x,y)
-   #define ROTL64(x,y)     rotl64(x,y)
+}
+
+void wyHashUpdate(WyHashState *state, const uint8_t *data, uint32_t len);
+
+inline uint64_t wyHashFinal(const WyHashState *state) {
+   uint64_t h = state->h;
+   if (state->len & 7)
+      h = wyMum(state->tail ^ wySecret1, h ^ wySecret2);
+   return wyMum(h ^ wySecret1, state->len ^ wySecret2);
+}
+
+// CRC32C (Castagnoli), the polynomial of the SSE4.2 crc32 instruction. crc32cUpdate uses the instruction when
+// the cpu has it and a table otherwise; both work on the raw register, crc32c inverts before and after.
+extern const uint32_t crc32cTable[256];
+uint32_t crc32cUpdate(uint32_t crc, const uint8_t *data, uint32_t len);
+inline uint32_t crc32c(const uint8_t *data, uint32_t len) {
+   return ~crc32cUpdate(0xffffffffu, data, len);
+}
+
+constexpr uint32_t crc32cBitsConst(uint32_t c, int n) {
+   return n == 0 ? c : crc32cBitsConst((c >> 1) ^ (0x82f63b78u & (0u - (c & 1))), n - 1);
+}
+constexpr uint32_t crc32cByteConst(uint32_t c, const char *s, uint32_t i) {
+   return crc32cBitsConst(c ^ (uint8_t)s[i], 8);
+}
+constexpr uint32_t crc32cBodyConst(const char *s, uint32_t len, uint32_t c) {  //4 bytes per recursion to keep the depth down
+   return len >= 4 ? crc32cBodyConst(s + 4, len - 4, crc32cByteConst(crc32cByteConst(crc32cByteConst(crc32cByteConst(c, s, 0), s, 1), s, 2), s, 3))
+        : len ? crc32cBodyConst(s + 1, len - 1, crc32cByteConst(c, s, 0))
+        : c;
+}
+constexpr uint32_t crc32cConst(const char *s, uint32_t len) {
+   return ~crc32cBodyConst(s, len, 0xffffffffu);
+}
+
+struct Crc32cState {
+   uint32_t crc;
+};
+
+inline void crc32cInit(Crc32cState *state) {
+   state->crc = 0xffffffffu;
+}
+
+inline void crc32cUpdate(Crc32cState *state, uint8_t byte) {
+   state->crc = crc32cTable[(state->crc ^ byte) & 0xff] ^ (state->crc >> 8);
+}
+
+inline void crc32cUpdate(Crc32cState *state, const uint8_t *data, uint32_t len) {
+   state->crc = crc32cUpdate(state->crc, data, len);
+}
+
+inline uint32_t crc32cFinal(const Crc32cState *state) {
+   return ~state->crc;
+}
+
+// Key hash policies. A policy supplies the hash type, a runtime hash, a constexpr hash for literals that
+// matches it, and an incremental State with init/update/finish, all as static members.
+struct Murmur3KeyHash {
+   typedef uint32_t hash_t;
+   typedef MurmurHashState State;
+   static hash_t hash(const uint8_t *data, uint32_t len) { return murmurHash(data, len); }
+   static constexpr hash_t hashConst(const char *s, uint32_t len) { return murmurHashConst(s, len); }
+   static void init(State *state) { murmurHashInit(state); }
+   static void update(State *state, uint8_t byte) { murmurHashUpdate(state, byte); }
+   static void update(State *state, const uint8_t *data, uint32_t len) { murmurHashUpdate(state, data, len); }
+   static hash_t finish(const State *state) { return murmurHashFinal(state); }
+};
+
+struct Murmur3KeyHash64 {
+   typedef uint64_t hash_t;
+   typedef MurmurHash64State State;
+   static hash_t hash(const uint8_t *data, uint32_t len) { return murmurHash64(data, len); }
+   static constexpr hash_t hashConst(const char *s, uint32_t len) { return murmurHash64Const(s, len); }
+   static void init(State *state) { murmurHash64Init(state); }
+   static void update(State *state, uint8_t byte) { murmurHash64Update(state, byte); }
+   static void update(State *state, const uint8_t *data, uint32_t len) { murmurHash64Update(state, data, len); }
+   static hash_t finish(const State *state) { return murmurHash64Final(state); }
+};
+
+template<typename T>  //uint64_t, or uint32_t for the two halves folded together
+struct WyKeyHash {
+   typedef T hash_t;
+   typedef WyHashState State;
+   static constexpr hash_t fold(uint64_t h) { return (hash_t)(sizeof(hash_t) == 8 ? h : h ^ (h >> 32)); }
+   static hash_t hash(const uint8_t *data, uint32_t len) { return fold(wyHash(data, len)); }
+   static constexpr hash_t hashConst(const char *s, uint32_t len) { return fold(wyHashConst(s, len)); }
+   static void init(State *state) { wyHashInit(state); }
+   static void update(State *state, uint8_t byte) { wyHashUpdate(state, byte); }
+   static void update(State *state, const uint8_t *data, uint32_t len) { wyHashUpdate(state, data, len); }
+   static hash_t finish(const State *state) { return fold(wyHashFinal(state)); }
+};
+
+struct Crc32cKeyHash {
+   typedef uint32_t hash_t;
+   typedef Crc32cState State;
+   static hash_t hash(const uint8_t *data, uint32_t len) { return crc32c(data, len); }
+   static constexpr hash_t hashConst(const char *s, uint32_t len) { return crc32cConst(s, len); }
+   static void init(State *state) { crc32cInit(state); }
+   static void update(State *state, uint8_t byte) { crc32cUpdate(state, byte); }
+   static void update(State *state, const uint8_t *data, uint32_t len) { crc32cUpdate(state, data, len); }
+   static hash_t finish(const State *state) { return crc32cFinal(state); }
+};
+
+// The key hash used by FixedMurmurHash, and so by sJSON object keys. Every file must see the same setting:
+//    EASTL_KEY_HASH_WY       wyKeyHash, fastest on short keys
+//    EASTL_KEY_HASH_CRC32C   CRC32C, in hardware with SSE4.2 (32bit only)
+//    EASTL_KEY_HASH_POLICY   a policy type of your own, declared before this header
+// and otherwise murmurHash. Define EASTL_MURMUR_HASH_64 for 64bit hashes (murmurHash64 for murmur): at 64 bits
+// collisions are rare enough that keys can be matched by hash alone, without their strings.
+#if defined(EASTL_KEY_HASH_POLICY)
+typedef EASTL_KEY_HASH_POLICY KeyHashPolicy;
+#elif defined(EASTL_KEY_HASH_CRC32C)
+#ifdef EASTL_MURMUR_HASH_64
+#error "CRC32C key hashes are 32bit, EASTL_MURMUR_HASH_64 needs another EASTL_KEY_HASH"
+#endif
+typedef Crc32cKeyHash KeyHashPolicy;
+#elif defined(EASTL_KEY_HASH_WY)
+#ifdef EASTL_MURMUR_HASH_64
+typedef WyKeyHash<uint64_t> KeyHashPolicy;
+#else
+typedef WyKeyHash<uint32_t> KeyHashPolicy;
+#endif
+#elif defined(EASTL_MURMUR_HASH_64)
+typedef Murmur3KeyHash64 KeyHashPolicy;
+#else
+typedef Murmur3KeyHash KeyHashPolicy;
 #endif
 
+typedef KeyHashPolicy::hash_t murmur_hash_t;
+typedef KeyHashPolicy::State MurmurKeyState;
+inline murmur_hash_t murmurKeyHash(const uint8_t *data, uint32_t len) { return KeyHashPolicy::hash(data, len); }
+constexpr murmur_hash_t murmurKeyConst(const char *s, uint32_t len) { return KeyHashPolicy::hashConst(s, len); }
+inline void murmurKeyInit(MurmurKeyState *state) { KeyHashPolicy::init(state); }
+inline void murmurKeyUpdate(MurmurKeyState *state, uint8_t byte) { KeyHashPolicy::update(state, byte); }
+inline void murmurKeyUpdate(MurmurKeyState *state, const uint8_t *data, uint32_t len) { KeyHashPolicy::update(state, data, len); }
+inline murmur_hash_t murmurKeyFinal(const MurmurKeyState *state) { return KeyHashPolicy::finish(state); }
 
-#define MIXDATA(x) k1 = x;                   \
-                   k1 *= c1;                 \
-                   k1 = ROTL32(k1, 15);      \
-                   k1 *= c2;                 \
-                   h1 ^= k1;                 \
-                   h1 = ROTL32(h1, 13);      \
-                   h1 = h1 * 5 + 0xe6546b64;
-#define MIXDATATAIL(x)  k1 = x;              \
-                        k1 *= c1;            \
-                        k1 = ROTL32(k1, 15); \
-                        k1 *= c2;            \
-                        h1 ^= k1;
+inline murmur_hash_t murmurKeyString(const char *buffer) {
+   return murmurKeyHash((const uint8_t*)buffer, (uint32_t)strlen(buffer));
+}
 
 struct FixedMurmurHash {
-   uint32_t mHash;
+   murmur_hash_t mHash;
    const char* mStr;
 
-   FixedMurmurHash()
+   constexpr FixedMurmurHash()
        : mHash(0), mStr(0)
    {}
 
+   constexpr FixedMurmurHash(murmur_hash_t hash, const char *str)
+       : mHash(hash), mStr(str)
+   {}
+
    bool operator==( const FixedMurmurHash lhs ) const {
        return ( mHash == lhs.mHash ) && ( ( mStr == lhs.mStr ) || ( mStr && lhs.mStr && !strcmp( mStr, lhs.mStr ) ) );
    }
@@ -81,1129 +402,32 @@ struct FixedMurmurHash {
    };
 
    FixedMurmurHash(ConstCharWrapper str)  //for dynamic strings
-      : mHash(murmurString(str.mStr))
+      : mHash(murmurKeyString(str.mStr))
       , mStr(str.mStr)
    {}
 
+   template<size_t N>
+   constexpr FixedMurmurHash(const char (&str)[N])  //for string literals of any length
+      : mHash(murmurKeyConst(str, N - 1))
+      , mStr(str)
+   {}
 
-   FixedMurmurHash(const char (&str)[2])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATATAIL(((str[ 0])));
-      h1 ^= 1;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[3])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATATAIL(((str[ 0]) | ((str[ 1])<<8)));
-      h1 ^= 2;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[4])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATATAIL(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16)));
-      h1 ^= 3;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[5])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-      h1 ^= 4;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[6])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATATAIL(((str[ 4])));
-      h1 ^= 5;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[7])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATATAIL(((str[ 4]) | ((str[ 5])<<8)));
-      h1 ^= 6;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[8])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATATAIL(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16)));
-      h1 ^= 7;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[9])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-      h1 ^= 8;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[10])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATATAIL(((str[ 8])));
-      h1 ^= 9;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[11])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATATAIL(((str[ 8]) | ((str[ 9])<<8)));
-      h1 ^= 10;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[12])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATATAIL(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16)));
-      h1 ^= 11;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[13])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-      h1 ^= 12;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[14])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATATAIL(((str[12])));
-      h1 ^= 13;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[15])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATATAIL(((str[12]) | ((str[13])<<8)));
-      h1 ^= 14;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[16])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATATAIL(((str[12]) | ((str[13])<<8) | ((str[14]) << 16)));
-      h1 ^= 15;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[17])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-      h1 ^= 16;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[18])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATATAIL(((str[16])));
-      h1 ^= 17;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[19])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATATAIL(((str[16]) | ((str[17])<<8)));
-      h1 ^= 18;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[20])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATATAIL(((str[16]) | ((str[17])<<8) | ((str[18]) << 16)));
-      h1 ^= 19;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[21])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-      h1 ^= 20;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[22])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATATAIL(((str[20])));
-      h1 ^= 21;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[23])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATATAIL(((str[20]) | ((str[21])<<8)));
-      h1 ^= 22;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[24])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATATAIL(((str[20]) | ((str[21])<<8) | ((str[22]) << 16)));
-      h1 ^= 23;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[25])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATA(((str[20]) | ((str[21])<<8) | ((str[22]) << 16) | ((str[23]) << 24)));
-      h1 ^= 24;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[26])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATA(((str[20]) | ((str[21])<<8) | ((str[22]) << 16) | ((str[23]) << 24)));
-         MIXDATATAIL(((str[24])));
-      h1 ^= 25;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[27])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATA(((str[20]) | ((str[21])<<8) | ((str[22]) << 16) | ((str[23]) << 24)));
-         MIXDATATAIL(((str[24]) | ((str[25])<<8) ));
-      h1 ^= 26;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[28])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATA(((str[20]) | ((str[21])<<8) | ((str[22]) << 16) | ((str[23]) << 24)));
-         MIXDATATAIL(((str[24]) | ((str[25])<<8) | ((str[26]) << 16)));
-      h1 ^= 27;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[29])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATA(((str[20]) | ((str[21])<<8) | ((str[22]) << 16) | ((str[23]) << 24)));
-         MIXDATA(((str[24]) | ((str[25])<<8) | ((str[26]) << 16) | ((str[27]) << 24)));
-      h1 ^= 28;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[30])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATA(((str[20]) | ((str[21])<<8) | ((str[22]) << 16) | ((str[23]) << 24)));
-         MIXDATA(((str[24]) | ((str[25])<<8) | ((str[26]) << 16) | ((str[27]) << 24)));
-         MIXDATATAIL((str[28]));
-
-      h1 ^= 28;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[31])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATA(((str[20]) | ((str[21])<<8) | ((str[22]) << 16) | ((str[23]) << 24)));
-         MIXDATA(((str[24]) | ((str[25])<<8) | ((str[26]) << 16) | ((str[27]) << 24)));
-         MIXDATATAIL((str[28]) | ((str[29])<<8));
-
-      h1 ^= 28;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[32])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATA(((str[20]) | ((str[21])<<8) | ((str[22]) << 16) | ((str[23]) << 24)));
-         MIXDATA(((str[24]) | ((str[25])<<8) | ((str[26]) << 16) | ((str[27]) << 24)));
-         MIXDATATAIL(((str[28]) | ((str[29])<<8) | ((str[30]) << 16)));
-      h1 ^= 28;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[33])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATA(((str[20]) | ((str[21])<<8) | ((str[22]) << 16) | ((str[23]) << 24)));
-         MIXDATA(((str[24]) | ((str[25])<<8) | ((str[26]) << 16) | ((str[27]) << 24)));
-         MIXDATA(((str[28]) | ((str[29])<<8) | ((str[30]) << 16) | ((str[31]) << 24)));
-      h1 ^= 28;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[34])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATA(((str[20]) | ((str[21])<<8) | ((str[22]) << 16) | ((str[23]) << 24)));
-         MIXDATA(((str[24]) | ((str[25])<<8) | ((str[26]) << 16) | ((str[27]) << 24)));
-         MIXDATA(((str[28]) | ((str[29])<<8) | ((str[30]) << 16) | ((str[31]) << 24)));
-         MIXDATATAIL((str[32]));
-      h1 ^= 28;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[35])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATA(((str[20]) | ((str[21])<<8) | ((str[22]) << 16) | ((str[23]) << 24)));
-         MIXDATA(((str[24]) | ((str[25])<<8) | ((str[26]) << 16) | ((str[27]) << 24)));
-         MIXDATA(((str[28]) | ((str[29])<<8) | ((str[30]) << 16) | ((str[31]) << 24)));
-         MIXDATATAIL((str[32]) | ((str[33])<<8));
-      h1 ^= 28;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[36])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATA(((str[20]) | ((str[21])<<8) | ((str[22]) << 16) | ((str[23]) << 24)));
-         MIXDATA(((str[24]) | ((str[25])<<8) | ((str[26]) << 16) | ((str[27]) << 24)));
-         MIXDATA(((str[28]) | ((str[29])<<8) | ((str[30]) << 16) | ((str[31]) << 24)));
-         MIXDATATAIL(((str[32]) | ((str[33])<<8) | ((str[34]) << 16)));
-      h1 ^= 28;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[37])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATA(((str[20]) | ((str[21])<<8) | ((str[22]) << 16) | ((str[23]) << 24)));
-         MIXDATA(((str[24]) | ((str[25])<<8) | ((str[26]) << 16) | ((str[27]) << 24)));
-         MIXDATA(((str[28]) | ((str[29])<<8) | ((str[30]) << 16) | ((str[31]) << 24)));
-         MIXDATA(((str[32]) | ((str[33])<<8) | ((str[34]) << 16) | ((str[35]) << 24)));
-      h1 ^= 28;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[38])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATA(((str[20]) | ((str[21])<<8) | ((str[22]) << 16) | ((str[23]) << 24)));
-         MIXDATA(((str[24]) | ((str[25])<<8) | ((str[26]) << 16) | ((str[27]) << 24)));
-         MIXDATA(((str[28]) | ((str[29])<<8) | ((str[30]) << 16) | ((str[31]) << 24)));
-         MIXDATA(((str[32]) | ((str[33])<<8) | ((str[34]) << 16) | ((str[35]) << 24)));
-         MIXDATATAIL((str[36]));
-      h1 ^= 28;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[39])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATA(((str[20]) | ((str[21])<<8) | ((str[22]) << 16) | ((str[23]) << 24)));
-         MIXDATA(((str[24]) | ((str[25])<<8) | ((str[26]) << 16) | ((str[27]) << 24)));
-         MIXDATA(((str[28]) | ((str[29])<<8) | ((str[30]) << 16) | ((str[31]) << 24)));
-         MIXDATA(((str[32]) | ((str[33])<<8) | ((str[34]) << 16) | ((str[35]) << 24)));
-         MIXDATATAIL((str[36]) | ((str[37])<<8));
-      h1 ^= 28;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[40])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATA(((str[20]) | ((str[21])<<8) | ((str[22]) << 16) | ((str[23]) << 24)));
-         MIXDATA(((str[24]) | ((str[25])<<8) | ((str[26]) << 16) | ((str[27]) << 24)));
-         MIXDATA(((str[28]) | ((str[29])<<8) | ((str[30]) << 16) | ((str[31]) << 24)));
-         MIXDATA(((str[32]) | ((str[33])<<8) | ((str[34]) << 16) | ((str[35]) << 24)));
-         MIXDATATAIL(((str[36]) | ((str[37])<<8) | ((str[38]) << 16)));
-      h1 ^= 28;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[41])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATA(((str[20]) | ((str[21])<<8) | ((str[22]) << 16) | ((str[23]) << 24)));
-         MIXDATA(((str[24]) | ((str[25])<<8) | ((str[26]) << 16) | ((str[27]) << 24)));
-         MIXDATA(((str[28]) | ((str[29])<<8) | ((str[30]) << 16) | ((str[31]) << 24)));
-         MIXDATA(((str[32]) | ((str[33])<<8) | ((str[34]) << 16) | ((str[35]) << 24)));
-         MIXDATA(((str[36]) | ((str[37])<<8) | ((str[38]) << 16) | ((str[39]) << 24)));
-      h1 ^= 28;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[42])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATA(((str[20]) | ((str[21])<<8) | ((str[22]) << 16) | ((str[23]) << 24)));
-         MIXDATA(((str[24]) | ((str[25])<<8) | ((str[26]) << 16) | ((str[27]) << 24)));
-         MIXDATA(((str[28]) | ((str[29])<<8) | ((str[30]) << 16) | ((str[31]) << 24)));
-         MIXDATA(((str[32]) | ((str[33])<<8) | ((str[34]) << 16) | ((str[35]) << 24)));
-         MIXDATA(((str[36]) | ((str[37])<<8) | ((str[38]) << 16) | ((str[39]) << 24)));
-         MIXDATATAIL((str[40]));
-      h1 ^= 28;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[43])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATA(((str[20]) | ((str[21])<<8) | ((str[22]) << 16) | ((str[23]) << 24)));
-         MIXDATA(((str[24]) | ((str[25])<<8) | ((str[26]) << 16) | ((str[27]) << 24)));
-         MIXDATA(((str[28]) | ((str[29])<<8) | ((str[30]) << 16) | ((str[31]) << 24)));
-         MIXDATA(((str[32]) | ((str[33])<<8) | ((str[34]) << 16) | ((str[35]) << 24)));
-         MIXDATA(((str[36]) | ((str[37])<<8) | ((str[38]) << 16) | ((str[39]) << 24)));
-         MIXDATATAIL((str[40]) | ((str[41])<<8));
-      h1 ^= 28;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[44])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATA(((str[20]) | ((str[21])<<8) | ((str[22]) << 16) | ((str[23]) << 24)));
-         MIXDATA(((str[24]) | ((str[25])<<8) | ((str[26]) << 16) | ((str[27]) << 24)));
-         MIXDATA(((str[28]) | ((str[29])<<8) | ((str[30]) << 16) | ((str[31]) << 24)));
-         MIXDATA(((str[32]) | ((str[33])<<8) | ((str[34]) << 16) | ((str[35]) << 24)));
-         MIXDATA(((str[36]) | ((str[37])<<8) | ((str[38]) << 16) | ((str[39]) << 24)));
-         MIXDATATAIL(((str[40]) | ((str[41])<<8) | ((str[42]) << 16)));
-      h1 ^= 28;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[45])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATA(((str[20]) | ((str[21])<<8) | ((str[22]) << 16) | ((str[23]) << 24)));
-         MIXDATA(((str[24]) | ((str[25])<<8) | ((str[26]) << 16) | ((str[27]) << 24)));
-         MIXDATA(((str[28]) | ((str[29])<<8) | ((str[30]) << 16) | ((str[31]) << 24)));
-         MIXDATA(((str[32]) | ((str[33])<<8) | ((str[34]) << 16) | ((str[35]) << 24)));
-         MIXDATA(((str[36]) | ((str[37])<<8) | ((str[38]) << 16) | ((str[39]) << 24)));
-         MIXDATA(((str[40]) | ((str[41])<<8) | ((str[42]) << 16) | ((str[43]) << 24)));
-      h1 ^= 28;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[46])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATA(((str[20]) | ((str[21])<<8) | ((str[22]) << 16) | ((str[23]) << 24)));
-         MIXDATA(((str[24]) | ((str[25])<<8) | ((str[26]) << 16) | ((str[27]) << 24)));
-         MIXDATA(((str[28]) | ((str[29])<<8) | ((str[30]) << 16) | ((str[31]) << 24)));
-         MIXDATA(((str[32]) | ((str[33])<<8) | ((str[34]) << 16) | ((str[35]) << 24)));
-         MIXDATA(((str[36]) | ((str[37])<<8) | ((str[38]) << 16) | ((str[39]) << 24)));
-         MIXDATA(((str[40]) | ((str[41])<<8) | ((str[42]) << 16) | ((str[43]) << 24)));
-         MIXDATATAIL((str[44]));
-      h1 ^= 28;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[47])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATA(((str[20]) | ((str[21])<<8) | ((str[22]) << 16) | ((str[23]) << 24)));
-         MIXDATA(((str[24]) | ((str[25])<<8) | ((str[26]) << 16) | ((str[27]) << 24)));
-         MIXDATA(((str[28]) | ((str[29])<<8) | ((str[30]) << 16) | ((str[31]) << 24)));
-         MIXDATA(((str[32]) | ((str[33])<<8) | ((str[34]) << 16) | ((str[35]) << 24)));
-         MIXDATA(((str[36]) | ((str[37])<<8) | ((str[38]) << 16) | ((str[39]) << 24)));
-         MIXDATA(((str[40]) | ((str[41])<<8) | ((str[42]) << 16) | ((str[43]) << 24)));
-         MIXDATATAIL((str[44]) | ((str[45])<<8));
-      h1 ^= 28;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[48])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATA(((str[20]) | ((str[21])<<8) | ((str[22]) << 16) | ((str[23]) << 24)));
-         MIXDATA(((str[24]) | ((str[25])<<8) | ((str[26]) << 16) | ((str[27]) << 24)));
-         MIXDATA(((str[28]) | ((str[29])<<8) | ((str[30]) << 16) | ((str[31]) << 24)));
-         MIXDATA(((str[32]) | ((str[33])<<8) | ((str[34]) << 16) | ((str[35]) << 24)));
-         MIXDATA(((str[36]) | ((str[37])<<8) | ((str[38]) << 16) | ((str[39]) << 24)));
-         MIXDATA(((str[40]) | ((str[41])<<8) | ((str[42]) << 16) | ((str[43]) << 24)));
-         MIXDATATAIL(((str[44]) | ((str[45])<<8) | ((str[46]) << 16)));
-      h1 ^= 28;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[49])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATA(((str[20]) | ((str[21])<<8) | ((str[22]) << 16) | ((str[23]) << 24)));
-         MIXDATA(((str[24]) | ((str[25])<<8) | ((str[26]) << 16) | ((str[27]) << 24)));
-         MIXDATA(((str[28]) | ((str[29])<<8) | ((str[30]) << 16) | ((str[31]) << 24)));
-         MIXDATA(((str[32]) | ((str[33])<<8) | ((str[34]) << 16) | ((str[35]) << 24)));
-         MIXDATA(((str[36]) | ((str[37])<<8) | ((str[38]) << 16) | ((str[39]) << 24)));
-         MIXDATA(((str[40]) | ((str[41])<<8) | ((str[42]) << 16) | ((str[43]) << 24)));
-         MIXDATA(((str[44]) | ((str[45])<<8) | ((str[46]) << 16) | ((str[47]) << 24)));
-      h1 ^= 28;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-   FixedMurmurHash(const char (&str)[50])
-    : mStr(str)
-   {
-      const uint32_t seed = 0;
-      uint32_t h1 = seed;
-      uint32_t c1 = 0xcc9e2d51;
-      uint32_t c2 = 0x1b873593;
-         uint32_t k1;
-         MIXDATA(((str[ 0]) | ((str[ 1])<<8) | ((str[ 2]) << 16) | ((str[ 3]) << 24)));
-         MIXDATA(((str[ 4]) | ((str[ 5])<<8) | ((str[ 6]) << 16) | ((str[ 7]) << 24)));
-         MIXDATA(((str[ 8]) | ((str[ 9])<<8) | ((str[10]) << 16) | ((str[11]) << 24)));
-         MIXDATA(((str[12]) | ((str[13])<<8) | ((str[14]) << 16) | ((str[15]) << 24)));
-         MIXDATA(((str[16]) | ((str[17])<<8) | ((str[18]) << 16) | ((str[19]) << 24)));
-         MIXDATA(((str[20]) | ((str[21])<<8) | ((str[22]) << 16) | ((str[23]) << 24)));
-         MIXDATA(((str[24]) | ((str[25])<<8) | ((str[26]) << 16) | ((str[27]) << 24)));
-         MIXDATA(((str[28]) | ((str[29])<<8) | ((str[30]) << 16) | ((str[31]) << 24)));
-         MIXDATA(((str[32]) | ((str[33])<<8) | ((str[34]) << 16) | ((str[35]) << 24)));
-         MIXDATA(((str[36]) | ((str[37])<<8) | ((str[38]) << 16) | ((str[39]) << 24)));
-         MIXDATA(((str[40]) | ((str[41])<<8) | ((str[42]) << 16) | ((str[43]) << 24)));
-         MIXDATA(((str[44]) | ((str[45])<<8) | ((str[46]) << 16) | ((str[47]) << 24)));
-         MIXDATATAIL((str[48]));
-      h1 ^= 28;
-      h1 ^= h1 >> 16;
-      h1 *= 0x85ebca6b;
-      h1 ^= h1 >> 13;
-      h1 *= 0xc2b2ae35;
-      h1 ^= h1 >> 16;
-      mHash = h1;
-   }
-
+   template<size_t N>
+   FixedMurmurHash(char (&str)[N])  //for char buffers, which may hold a shorter string
+      : mHash(murmurKeyString(str))
+      , mStr(str)
+   {}
 };
 
-#undef MIXDATA
-#undef FORCE_INLINE
-#undef ROTL32
-#undef ROTL64
+// Only compiles if the hash can be computed at compile time, use it as a guarantee in hot paths:
+//    sJSONgetObjectItem(object, EASTL_MURMUR_KEY("a_long_descriptive_key_name"))
+// FixedMurmurHash("...").mHash can also be checked with static_assert.
+template<murmur_hash_t H> struct MurmurConstant { static const murmur_hash_t value = H; };
+#define EASTL_MURMUR_KEY(str) eastl::FixedMurmurHash(eastl::MurmurConstant<eastl::FixedMurmurHash(str).mHash>::value, str)
+
+static_assert(murmurHashConst("testtesttesttesttesttesttest", 28) == 0x9419e513u, "murmurHashConst must fold at compile time");
+static_assert(murmurHash64Const("testtesttesttesttesttesttest", 28) == 0xdc69393ce904673cull, "murmurHash64Const must fold at compile time");
+static_assert(crc32cConst("123456789", 9) == 0xe3069283u, "crc32cConst must fold at compile time");
 
 //void main() {
 //   uint32_t test3 = FixedMurmurHash("testtesttesttesttesttesttest");
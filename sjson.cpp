@@ -32,6 +32,38 @@
 #include <float.h>
 #include <limits.h>
 #include <ctype.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+   #define sJSON_SSE2
+   #include <emmintrin.h>
+#endif
+#ifdef _WIN32
+   #include <process.h>
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+   #define sJSON_MMAP
+   #include <fcntl.h>
+   #include <sys/mman.h>
+   #include <sys/stat.h>
+   #include <unistd.h>
+#endif
+#ifdef sJSON_PROFILE
+   #if defined(_MSC_VER)
+      #include <intrin.h>
+      #define sJSON_TICKS() __rdtsc()
+   #elif defined(__x86_64__) || defined(__i386__)
+      #include <x86intrin.h>
+      #define sJSON_TICKS() __rdtsc()
+   #else
+      #include <chrono>
+      #define sJSON_TICKS() (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count()
+   #endif
+#endif
 #include "sjson.h"
 
 /* sjson: - no {} needed around the whole file
@@ -39,7 +71,14 @@
           - quotes around the key are optional
           - commas after values are optional */
 
-static const char *ep;
+static thread_local const char *ep;
+static thread_local int parse_lazy = 0;      /* set while materializing a lazily parsed container */
+static thread_local int parse_worker = 0;    /* set on sJSONparseMany's threads, which leave the key table alone */
+static int parse_options = 0;
+static int parse_threads = 0;
+
+void sJSONsetParseOptions(int options) {parse_options=options;}
+void sJSONsetParseThreads(int threads) {parse_threads=threads;}
 
 const char *sJSONgetErrorPtr() {return ep;}
 
@@ -47,21 +86,108 @@ inline static int compareNames( const sJSON* c, eastl::FixedMurmurHash hash )
 {
     if( c->nameHash == hash.mHash )
     {
-       if( !c->nameString && !hash.mStr )
+       if( c->nameString == hash.mStr )  /* also matches interned keys without a strcmp */
        {
           return 0;
        }
-       if( !hash.mStr )
+       if( !hash.mStr || !c->nameString )
        {
+#ifdef EASTL_MURMUR_HASH_64
+          return 0;   /* hash only lookup or stripped key, a 64bit hash is trusted alone */
+#else
           return 1;
+#endif
        }
         return strcmp( c->nameString, hash.mStr );
     }
     return 1;
 }
 
-static void *(*sJSON_malloc)(size_t sz) = malloc;
-static void (*sJSON_free)(void *ptr) = free;
+static void *(*malloc_hook)(size_t sz) = malloc;
+static void (*free_hook)(void *ptr) = free;
+
+/* PROFILE(phase) charges the ticks until the end of the enclosing block to phase, less those charged to
+   phases entered inside it, so the phases add up to the time spent. Both compile to nothing without
+   sJSON_PROFILE. */
+#ifdef sJSON_PROFILE
+static thread_local sJSONProfile profile;
+static thread_local uint64_t profile_inner;     /* ticks charged inside the innermost open phase */
+struct profile_phase {
+   profile_phase(sJSONPhase *phase) : phase(phase), outer(profile_inner), start(sJSON_TICKS()) {profile_inner=0;}
+   ~profile_phase() {
+      uint64_t ticks=sJSON_TICKS()-start;
+      phase->ticks+=ticks-profile_inner;
+      phase->calls++;
+      profile_inner=outer+ticks;
+   }
+   sJSONPhase *phase;
+   uint64_t outer, start;
+};
+void sJSONgetProfile(sJSONProfile *out) {*out=profile;}
+void sJSONresetProfile() {memset(&profile,0,sizeof(profile));}
+static void add_profile(sJSONProfile *to, const sJSONProfile *from) {
+   sJSONPhase *t=(sJSONPhase*)to;
+   const sJSONPhase *f=(const sJSONPhase*)from;
+   for (size_t i=0;i<sizeof(sJSONProfile)/sizeof(sJSONPhase);i++) {
+      t[i].ticks+=f[i].ticks;
+      t[i].calls+=f[i].calls;
+      t[i].bytes+=f[i].bytes;
+   }
+}
+   #define PROFILE(phase) profile_phase profiled(&profile.phase)
+   #define PROFILE_BYTES(phase,n) (profile.phase.bytes+=(n))
+#else
+   #define PROFILE(phase)
+   #define PROFILE_BYTES(phase,n) ((void)sizeof(n))
+#endif
+
+/* Every allocation goes through these, counting into the thread's stats. */
+static thread_local sJSONStats stats;
+static void *sJSON_malloc(size_t sz) {
+   PROFILE(alloc);
+   PROFILE_BYTES(alloc,sz);
+   stats.allocations++;
+   stats.bytes+=sz;
+   return malloc_hook(sz);
+}
+static void sJSON_free(void *ptr) {
+   PROFILE(free);
+   if (ptr)
+      stats.frees++;
+   free_hook(ptr);
+}
+static void add_stats(sJSONStats *to, const sJSONStats *from) {
+   to->allocations+=from->allocations;
+   to->frees+=from->frees;
+   to->bytes+=from->bytes;
+   to->nodes+=from->nodes;
+   to->stringBytes+=from->stringBytes;
+   to->keyBytes+=from->keyBytes;
+}
+void sJSONgetStats(sJSONStats *out) {*out=stats;}
+void sJSONresetStats() {memset(&stats,0,sizeof(stats));}
+
+/* What worker threads counted, given to the thread that started them once they finish. */
+typedef struct sJSONWorkerTotals {
+   sJSONStats stats;
+#ifdef sJSON_PROFILE
+   sJSONProfile profile;
+#endif
+} sJSONWorkerTotals;
+/* Called by a worker as it finishes, under the lock guarding totals. */
+static void add_worker_totals(sJSONWorkerTotals *totals) {
+   add_stats(&totals->stats,&stats);
+#ifdef sJSON_PROFILE
+   add_profile(&totals->profile,&profile);
+#endif
+}
+/* Called by the starting thread once every worker has finished. */
+static void take_worker_totals(const sJSONWorkerTotals *totals) {
+   add_stats(&stats,&totals->stats);
+#ifdef sJSON_PROFILE
+   add_profile(&profile,&totals->profile);
+#endif
+}
 
 static char* sJSON_strdup(const char* str) {
    size_t len;
@@ -76,33 +202,374 @@ static char* sJSON_strdup(const char* str) {
 
 void sJSONinitHooks(sJSON_Hooks* hooks) {
    if (!hooks) { /* Reset hooks */
-     sJSON_malloc = malloc;
-     sJSON_free = free;
+     malloc_hook = malloc;
+     free_hook = free;
      return;
    }
 
-   sJSON_malloc = (hooks->malloc_fn)?hooks->malloc_fn:malloc;
-   sJSON_free	 = (hooks->free_fn)?hooks->free_fn:free;
+   malloc_hook = (hooks->malloc_fn)?hooks->malloc_fn:malloc;
+   free_hook	 = (hooks->free_fn)?hooks->free_fn:free;
+}
+
+/* Key intern table: open addressed on nameHash, each distinct key is allocated once. */
+typedef struct sJSONKeyEntry {
+   eastl::murmur_hash_t hash;
+   char *key;
+} sJSONKeyEntry;
+
+struct sJSONKeyTable {
+   sJSONKeyEntry *entries;
+   uint32_t capacity;         /* always a power of two */
+   uint32_t count;
+};
+
+static sJSONKeyTable *sJSON_keys = 0;
+
+sJSONKeyTable *sJSONcreateKeyTable() {
+   sJSONKeyTable *table = (sJSONKeyTable*)sJSON_malloc(sizeof(sJSONKeyTable));
+   if (!table)
+      return 0;
+   table->capacity = 64;
+   table->count = 0;
+   table->entries = (sJSONKeyEntry*)sJSON_malloc(table->capacity*sizeof(sJSONKeyEntry));
+   if (!table->entries) {
+      sJSON_free(table);
+      return 0;
+   }
+   memset(table->entries,0,table->capacity*sizeof(sJSONKeyEntry));
+   return table;
+}
+
+void sJSONdeleteKeyTable(sJSONKeyTable *table) {
+   uint32_t i;
+   if (!table)
+      return;
+   if (sJSON_keys == table)
+      sJSON_keys = 0;
+   for (i=0;i<table->capacity;i++)
+      if (table->entries[i].key)
+         sJSON_free(table->entries[i].key);
+   sJSON_free(table->entries);
+   sJSON_free(table);
+}
+
+void sJSONsetKeyTable(sJSONKeyTable *table) {
+   sJSON_keys = table;
+}
+
+static int grow_key_table(sJSONKeyTable *table) {
+   uint32_t i, capacity = table->capacity*2;
+   sJSONKeyEntry *entries = (sJSONKeyEntry*)sJSON_malloc(capacity*sizeof(sJSONKeyEntry));
+   if (!entries)
+      return 0;
+   memset(entries,0,capacity*sizeof(sJSONKeyEntry));
+   for (i=0;i<table->capacity;i++) {
+      sJSONKeyEntry *e = &table->entries[i];
+      if (e->key) {
+         uint32_t slot = (uint32_t)e->hash & (capacity-1);
+         while (entries[slot].key)
+            slot = (slot+1) & (capacity-1);
+         entries[slot] = *e;
+      }
+   }
+   sJSON_free(table->entries);
+   table->entries = entries;
+   table->capacity = capacity;
+   return 1;
+}
+
+/* Return the table's copy of key, adding it if needed. */
+static char *intern_key(sJSONKeyTable *table, const char *key, eastl::murmur_hash_t hash) {
+   uint32_t slot = (uint32_t)hash & (table->capacity-1);
+   sJSONKeyEntry *e;
+   while ((e = &table->entries[slot])->key) {
+      if (e->hash == hash && !strcmp(e->key,key))
+         return e->key;
+      slot = (slot+1) & (table->capacity-1);
+   }
+   if ((table->count+1)*2 > table->capacity) {
+      if (!grow_key_table(table))
+         return 0;
+      return intern_key(table,key,hash);
+   }
+   stats.keyBytes+=strlen(key)+1;
+   if (!(e->key = sJSON_strdup(key)))
+      return 0;
+   e->hash = hash;
+   table->count++;
+   return e->key;
+}
+
+eastl::FixedMurmurHash sJSONinternKey(sJSONKeyTable *table, const char *string) {
+   eastl::FixedMurmurHash hash;
+   hash.mHash = eastl::murmurKeyString(string);
+   hash.mStr = intern_key(table,string,hash.mHash);
+   return hash;
+}
+
+/* Set the name of an item, sharing the key through the current key table if there is one. */
+static int set_name(sJSON *item, const char *string, eastl::murmur_hash_t hash) {
+   if (item->nameString && !(item->type&sJSON_IsInterned))
+      sJSON_free(item->nameString);
+   item->type &= ~sJSON_IsInterned;
+   item->nameHash = hash;
+   if (sJSON_keys) {
+      item->nameString = intern_key(sJSON_keys,string,hash);
+      if (item->nameString)
+         item->type |= sJSON_IsInterned;
+   } else {
+      stats.keyBytes+=strlen(string)+1;
+      item->nameString = sJSON_strdup(string);
+   }
+   return item->nameString != 0;
+}
+
+/* Growable byte buffer for building output. */
+typedef struct sJSONBuffer {
+   char *data;
+   uint32_t size, capacity;
+} sJSONBuffer;
+
+static int buffer_append(sJSONBuffer *b, const void *data, uint32_t len) {
+   if (b->size+len > b->capacity) {
+      uint32_t capacity = b->capacity ? b->capacity*2 : 256;
+      char *grown;
+      while (capacity < b->size+len)
+         capacity*=2;
+      if (!(grown=(char*)sJSON_malloc(capacity)))
+         return 0;
+      if (b->data) {
+         memcpy(grown,b->data,b->size);
+         sJSON_free(b->data);
+      }
+      b->data=grown;
+      b->capacity=capacity;
+   }
+   memcpy(b->data+b->size,data,len);
+   b->size+=len;
+   return 1;
+}
+static int buffer_append_string(sJSONBuffer *b, const char *str) {
+   return buffer_append(b,str,(uint32_t)strlen(str));
+}
+/* Little endian, so binary deltas move between platforms. */
+static int buffer_append_u32(sJSONBuffer *b, uint32_t v) {
+   unsigned char bytes[4] = {(unsigned char)v, (unsigned char)(v>>8), (unsigned char)(v>>16), (unsigned char)(v>>24)};
+   return buffer_append(b,bytes,4);
+}
+static uint32_t read_u32(const char *p) {
+   const unsigned char *b=(const unsigned char*)p;
+   return b[0] | (b[1]<<8) | (b[2]<<16) | ((uint32_t)b[3]<<24);
+}
+
+/* Change journal. Every item of the tracked tree is mapped to its parent, so the JSON Pointer of a change
+   can be built when it happens without searching the tree. Operations are stored in the binary delta
+   format: op byte, u32 path length, path, u32 value length, unformatted value. */
+#define JOURNAL_ADD 0
+#define JOURNAL_REMOVE 1
+#define JOURNAL_REPLACE 2
+static const char *journal_ops[3] = {"add", "remove", "replace"};
+static const char journal_magic[4] = {'s','J','D','1'};
+
+typedef struct sJSONParentEntry {
+   sJSON *item;
+   sJSON *parent;
+} sJSONParentEntry;
+
+struct sJSONJournal {
+   sJSON *root;
+   sJSONParentEntry *parents;    /* open addressed on the item pointer */
+   uint32_t capacity, count;
+   sJSONBuffer ops;
+   int failed;
+};
+
+static sJSONJournal *journal = 0;
+
+static uint32_t parent_slot(const sJSONJournal *j, const sJSON *item) {
+   return (uint32_t)(((size_t)item >> 4) * 2654435761u) & (j->capacity-1);
+}
+static sJSON *journal_parent(const sJSONJournal *j, const sJSON *item) {
+   uint32_t slot=parent_slot(j,item);
+   while (j->parents[slot].item) {
+      if (j->parents[slot].item==item)
+         return j->parents[slot].parent;
+      slot=(slot+1)&(j->capacity-1);
+   }
+   return 0;
+}
+static int journal_tracks(const sJSONJournal *j, const sJSON *item) {
+   return item==j->root || journal_parent(j,item);
+}
+static void journal_insert(sJSONJournal *j, sJSON *item, sJSON *parent) {
+   uint32_t slot, i;
+   if ((j->count+1)*2 > j->capacity) {
+      sJSONParentEntry *old=j->parents;
+      uint32_t capacity=j->capacity;
+      if (!(j->parents=(sJSONParentEntry*)sJSON_malloc(capacity*2*sizeof(sJSONParentEntry)))) {
+         j->parents=old;
+         j->failed=1;
+         return;
+      }
+      memset(j->parents,0,capacity*2*sizeof(sJSONParentEntry));
+      j->capacity=capacity*2;
+      j->count=0;
+      for (i=0;i<capacity;i++)
+         if (old[i].item)
+            journal_insert(j,old[i].item,old[i].parent);
+      sJSON_free(old);
+   }
+   slot=parent_slot(j,item);
+   while (j->parents[slot].item && j->parents[slot].item!=item)
+      slot=(slot+1)&(j->capacity-1);
+   if (!j->parents[slot].item)
+      j->count++;
+   j->parents[slot].item=item;
+   j->parents[slot].parent=parent;
+}
+static void journal_erase(sJSONJournal *j, const sJSON *item) {
+   uint32_t slot=parent_slot(j,item), next, home;
+   while (j->parents[slot].item!=item) {
+      if (!j->parents[slot].item)
+         return;
+      slot=(slot+1)&(j->capacity-1);
+   }
+   /* shift later entries of the probe run back so lookups never stop early */
+   for (next=(slot+1)&(j->capacity-1);j->parents[next].item;next=(next+1)&(j->capacity-1)) {
+      home=parent_slot(j,j->parents[next].item);
+      if (((next-home)&(j->capacity-1)) >= ((next-slot)&(j->capacity-1))) {
+         j->parents[slot]=j->parents[next];
+         slot=next;
+      }
+   }
+   j->parents[slot].item=0;
+   j->count--;
+}
+static void journal_track(sJSONJournal *j, sJSON *item, sJSON *parent) {
+   sJSON *c;
+   journal_insert(j,item,parent);
+   if (!(item->type&sJSON_IsReference))
+      for (c=item->child;c;c=c->next)
+         journal_track(j,c,item);
+}
+static void journal_untrack(sJSONJournal *j, sJSON *item) {
+   sJSON *c;
+   journal_erase(j,item);
+   if (!(item->type&sJSON_IsReference))
+      for (c=item->child;c;c=c->next)
+         journal_untrack(j,c);
+}
+
+/* Append the JSON Pointer reference token of child within parent. */
+static int append_segment(sJSONBuffer *b, const sJSON *parent, const sJSON *child, int append) {
+   char index[16];
+   const char *key;
+   uint32_t i=0;
+   if ((parent->type&255)==sJSON_Object) {
+      for (key=child->nameString;key && *key;key++)
+         if (!(*key=='~' ? buffer_append(b,"~0",2) : *key=='/' ? buffer_append(b,"~1",2) : buffer_append(b,key,1)))
+            return 0;
+      return 1;
+   }
+   if (append)
+      return buffer_append(b,"-",1);
+   while ((child=child->prev))
+      i++;
+   sprintf(index,"%u",i);
+   return buffer_append_string(b,index);
+}
+static int append_path(const sJSONJournal *j, sJSONBuffer *b, const sJSON *item) {
+   const sJSON *parent;
+   if (item==j->root)
+      return 1;
+   parent=journal_parent(j,item);
+   return parent && append_path(j,b,parent) && buffer_append(b,"/",1) && append_segment(b,parent,item,0);
+}
+
+static char *print_value(sJSON *item,int depth,int fmt);
+
+/* Record an operation on child within parent. value is the new item for add and replace. */
+static void journal_record(sJSONJournal *j, int op, sJSON *parent, sJSON *child, sJSON *value) {
+   sJSONBuffer path={0,0,0};
+   char *text=0;
+   uint32_t start=j->ops.size;
+   char opcode=(char)op;
+   int ok;
+   ok = append_path(j,&path,parent) && buffer_append(&path,"/",1)
+      && append_segment(&path,parent,child,op==JOURNAL_ADD && !child->next);
+   if (ok && value)
+      ok = (text=print_value(value,0,0))!=0;
+   ok = ok && buffer_append(&j->ops,&opcode,1) && buffer_append_u32(&j->ops,path.size)
+      && buffer_append(&j->ops,path.data,path.size) && buffer_append_u32(&j->ops,text ? (uint32_t)strlen(text) : 0)
+      && (!text || buffer_append_string(&j->ops,text));
+   if (!ok) {
+      j->ops.size=start;
+      j->failed=1;
+   }
+   if (path.data)
+      sJSON_free(path.data);
+   if (text)
+      sJSON_free(text);
+}
+
+/* Hooks for the mutation functions, only called while a journal is set. */
+static void journal_added(sJSON *parent, sJSON *item) {
+   if (!journal_tracks(journal,parent))
+      return;
+   journal_track(journal,item,parent);
+   journal_record(journal,JOURNAL_ADD,parent,item,item);
+}
+static void journal_removed(sJSON *parent, sJSON *item) {
+   if (!journal_tracks(journal,parent))
+      return;
+   journal_record(journal,JOURNAL_REMOVE,parent,item,0);
+   journal_untrack(journal,item);
+}
+static void journal_replaced(sJSON *parent, sJSON *item, sJSON *newitem) {
+   if (!journal_tracks(journal,parent))
+      return;
+   journal_record(journal,JOURNAL_REPLACE,parent,item,newitem);
+   journal_untrack(journal,item);
+   journal_track(journal,newitem,parent);
+}
+static void journal_materialized(sJSON *item) {
+   sJSON *c;
+   if (journal_tracks(journal,item))
+      for (c=item->child;c;c=c->next)
+         journal_track(journal,c,item);
+}
+
+/* Copy a string value. */
+static char *copy_value(const char *string) {
+   stats.stringBytes+=strlen(string)+1;
+   return sJSON_strdup(string);
 }
 
 /* Internal constructor. */
 static sJSON *sJSON_New_Item() {
 	sJSON* node = (sJSON*)sJSON_malloc(sizeof(sJSON));
+   stats.nodes++;
    if (node)
       memset(node,0,sizeof(sJSON));
 	return node;
 }
 
 /* Delete a sJSON structure. */
+static void free_frozen(sJSON *root);
 void sJSONdelete(sJSON *c) {
 	sJSON *next;
+   if (c && (c->type&sJSON_IsFrozen)) {
+      if (c->type&sJSON_IsFrozenRoot)
+         free_frozen(c);
+      return;     /* the rest of a frozen tree goes with its root */
+   }
    while (c) {
 		next=c->next;
       if (!(c->type&sJSON_IsReference) && c->child)
          sJSONdelete(c->child);
-      if (!(c->type&sJSON_IsReference) && c->valueString)
+      if (!(c->type&(sJSON_IsReference|sJSON_IsLazy)) && c->valueString)
          sJSON_free(c->valueString);
-      if (c->nameString)
+      if (c->nameString && !(c->type&sJSON_IsInterned))
          sJSON_free(c->nameString);
 		sJSON_free(c);
 		c=next;
@@ -111,6 +578,8 @@ void sJSONdelete(sJSON *c) {
 
 /* Parse the input text to generate a number, and populate the result into item. */
 static const char *parse_number(sJSON *item, const char *num) {
+   PROFILE(number);
+   PROFILE_BYTES(number,strspn(num,"+-.0123456789eE"));
    double n=0,sign=1,scale=0;
    int subscale=0,signsubscale=1;
 
@@ -132,170 +601,285 @@ static const char *parse_number(sJSON *item, const char *num) {
 	return num;
 }
 
-/* Render the number nicely from the given item into a string. */
-static char *print_number(sJSON *item) {
-	char *str;
-   double d=item->valueDouble;
-   if (fabs(((double)item->valueInt)-d)<=DBL_EPSILON && d<=INT_MAX && d>=INT_MIN) {
-		str=(char*)sJSON_malloc(21);	/* 2^64+1 can be represented in 21 chars. */
-      if (str)
-         sprintf(str,"%d",item->valueInt);
-   } else {
-		str=(char*)sJSON_malloc(64);	/* This is a nice tradeoff. */
-      if (str) {
-         if (fabs(floor(d)-d)<=DBL_EPSILON)
-            sprintf(str,"%.0f",d);
-         else if (fabs(d)<1.0e-6 || fabs(d)>1.0e9)
-            sprintf(str,"%e",d);
-         else
-            sprintf(str,"%f",d);
-		}
-	}
-	return str;
+/* Render an int like %d, two digits at a time. */
+static const char digit_pairs[]=
+   "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+   "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+   "8081828384858687888990919293949596979899";
+static int format_int(char *out, int32_t value) {
+   char digits[12], *p=digits+sizeof(digits);
+   uint32_t u = value<0 ? 0u-(uint32_t)value : (uint32_t)value;
+   int len;
+   while (u>=100) {
+      p-=2;
+      memcpy(p,digit_pairs+2*(u%100),2);
+      u/=100;
+   }
+   if (u>=10) {
+      p-=2;
+      memcpy(p,digit_pairs+2*u,2);
+   } else
+      *--p=(char)('0'+u);
+   if (value<0)
+      *--p='-';
+   len=(int)(digits+sizeof(digits)-p);
+   memcpy(out,p,len);
+   out[len]=0;
+   return len;
 }
 
-static const char *parse_string(sJSON *item,const char *str);
-
-static const char *parse_string_or_identifier(sJSON *item,const char *str) {
-   if(*str == '\"')
-      return parse_string(item, str);
-
-   //parse identifier
-   char c = *str;
-   if(c == '_' || (c >= 'a' && c <= 'z') || (c>='A' && c<='Z') ) {
-      const char *ptr = str;
-      int len = 0;
-      while(*ptr && ( *ptr=='_' ||
-                     (*ptr>='a' && *ptr<='z') ||
-                     (*ptr>='A' && *ptr<='Z') ||
-                     (*ptr>='0' && *ptr<='9')   )) {
-         ptr++;
-         len++;
-      }
-      char *out = (char*)sJSON_malloc(len+1);   /* This is how long we need for the string, roughly. */
-      if(!out) return 0;
-
-      ptr = str;
-      char *ptr2 = out;
-      while(*ptr && ( *ptr=='_' ||
-                     (*ptr>='a' && *ptr<='z') ||
-                     (*ptr>='A' && *ptr<='Z') ||
-                     (*ptr>='0' && *ptr<='9')   )) {
-         *(ptr2++) = *(ptr++);
-      }
-      *ptr2 = '\0';
-
-      item->valueString=out;
-      item->type=sJSON_String;
-      return ptr;
+/* Render a number nicely into out, which needs 320 chars: DBL_MAX is 309 digits with %.0f. Returns the length. */
+static int format_number(char *out, int i, double d) {
+   if (fabs(((double)i)-d)<=DBL_EPSILON && d<=INT_MAX && d>=INT_MIN)
+      return format_int(out,i);
+   if (fabs(floor(d)-d)<=DBL_EPSILON)
+      return sprintf(out,"%.0f",d);
+   if (fabs(d)<1.0e-6 || fabs(d)>1.0e9)
+      return sprintf(out,"%e",d);
+   return sprintf(out,"%f",d);
+}
 
-   } else {
-      ep = str;      /* not an identifier! */
-      return 0;
-   }
+/* Render the number nicely from the given item into a string. */
+static char *print_number(sJSON *item) {
+   PROFILE(printNumber);
+   char str[320];
+   int len=format_number(str,item->valueInt,item->valueDouble);
+   PROFILE_BYTES(printNumber,len);
+   return sJSON_strdup(str);
 }
 
-/* Parse the input text into an unescaped cstring, and populate item. */
-static const unsigned char firstByteMark[7] = { 0x00, 0x00, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC };
-static const char *parse_string(sJSON *item, const char *str) {
+/* Length of the quoted string at str once unescaped, roughly. */
+static int string_length(const char *str) {
    const char *ptr=str+1;
-   char *ptr2;
-   char *out;
    int len=0;
-   unsigned uc;
-   if (*str!='\"') {
-      ep=str;     /* not a string! */
-      return 0;
-   }
-	
    while (*ptr!='\"' && *ptr && ++len)
-      if (*ptr++ == '\\')
+      if (*ptr++ == '\\' && *ptr)
          ptr++;	/* Skip escaped quotes. */
-	
-	out=(char*)sJSON_malloc(len+1);	/* This is how long we need for the string, roughly. */
-   if (!out)
-      return 0;
-	
-   ptr=str+1;
-   ptr2=out;
+   return len;
+}
+
+/* Value of each hex digit, -1 for any other char. */
+static const signed char hex_digit[256] = {
+   -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+   -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+   -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9,-1,-1,-1,-1,-1,-1,
+   -1,10,11,12,13,14,15,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+   -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+   -1,10,11,12,13,14,15,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+   -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+   -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+   -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+   -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+   -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+   -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+   -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+   -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+   -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1
+};
+/* The 4 hex digits at str as a number, or -1. Stops at the first bad char, so never reads past a NUL. */
+static int parse_hex4(const char *str) {
+   const unsigned char *s=(const unsigned char*)str;
+   int a, b, c, d;
+   if ((a=hex_digit[s[0]])<0 || (b=hex_digit[s[1]])<0 || (c=hex_digit[s[2]])<0 || (d=hex_digit[s[3]])<0)
+      return -1;
+   return a<<12 | b<<8 | c<<4 | d;
+}
+
+/* Unescape the quoted string at str into out, feeding the result to hash if there is one. The hash stops at
+   a \u0000, where out ends as a C string. Returns 0 at a \u escape without 4 hex digits. */
+static const unsigned char firstByteMark[7] = { 0x00, 0x00, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC };
+static const char *unescape_string(const char *str, char *out, eastl::MurmurKeyState *hash) {
+   const char *ptr=str+1;
+   char *ptr2=out;
+   int len, low, uc;
    while (*ptr!='\"' && *ptr) {
-      if (*ptr!='\\')
+      if (*ptr!='\\') {
+         if (hash)
+            eastl::murmurKeyUpdate(hash,(uint8_t)*ptr);
          *ptr2++=*ptr++;
-      else {
-			ptr++;
+      } else {
+			if (!*++ptr)
+				break;	/* a backslash ending the text */
          switch (*ptr) {
 				case 'b': *ptr2++='\b';	break;
 				case 'f': *ptr2++='\f';	break;
 				case 'n': *ptr2++='\n';	break;
 				case 'r': *ptr2++='\r';	break;
 				case 't': *ptr2++='\t';	break;
-				case 'u':	 /* transcode utf16 to utf8. DOES NOT SUPPORT SURROGATE PAIRS CORRECTLY. */
-					sscanf(ptr+1,"%4x",&uc);	/* get the unicode char. */
-					len=3;if (uc<0x80) len=1;else if (uc<0x800) len=2;ptr2+=len;
-					
+				case 'u':	 /* transcode utf16 to utf8, joining surrogate pairs. */
+					if ((uc=parse_hex4(ptr+1))<0) {
+						ep=ptr-1;
+						*ptr2=0;
+						return 0;
+					}
+					ptr+=4;
+					if (uc>=0xD800 && uc<=0xDBFF && ptr[1]=='\\' && ptr[2]=='u' && (low=parse_hex4(ptr+3))>=0xDC00 && low<=0xDFFF) {
+						uc=0x10000+((uc-0xD800)<<10)+(low-0xDC00);
+						ptr+=6;
+					} else if (uc>=0xD800 && uc<=0xDFFF) {
+						uc=0xFFFD;	/* a lone surrogate has no utf8 form */
+					} else if (!uc) {
+						hash=0;	/* a name read as a C string ends here */
+					}
+					len=4;if (uc<0x80) len=1;else if (uc<0x800) len=2;else if (uc<0x10000) len=3;ptr2+=len;
+
 					switch (len) {
-						case 3: *--ptr2 =((uc | 0x80) & 0xBF); uc >>= 6;
-						case 2: *--ptr2 =((uc | 0x80) & 0xBF); uc >>= 6;
+						case 4: *--ptr2 =((uc | 0x80) & 0xBF); uc >>= 6;	/* fall through */
+						case 3: *--ptr2 =((uc | 0x80) & 0xBF); uc >>= 6;	/* fall through */
+						case 2: *--ptr2 =((uc | 0x80) & 0xBF); uc >>= 6;	/* fall through */
 						case 1: *--ptr2 =(uc | firstByteMark[len]);
 					}
-					ptr2+=len;ptr+=4;
-					break;
+					ptr2+=len;
+					if (hash)
+						eastl::murmurKeyUpdate(hash,(const uint8_t*)ptr2-len,len);
+					ptr++;
+					continue;
 				default:  *ptr2++=*ptr; break;
 			}
+			if (hash)
+				eastl::murmurKeyUpdate(hash,(uint8_t)ptr2[-1]);
 			ptr++;
 		}
 	}
 	*ptr2=0;
    if (*ptr=='\"')
       ptr++;
+   return ptr;
+}
+
+/* Parse the input text into an unescaped cstring, and populate item. */
+static const char *parse_string(sJSON *item, const char *str) {
+   PROFILE(string);
+   char *out;
+   if (*str!='\"') {
+      ep=str;     /* not a string! */
+      return 0;
+   }
+   int len=string_length(str)+1;	/* This is how long we need for the string, roughly. */
+   stats.stringBytes+=len;
+	out=(char*)sJSON_malloc(len);
+   if (!out)
+      return 0;
+   const char *end=unescape_string(str,out,0);
+   PROFILE_BYTES(string,end-str);
    item->valueString=out;
 	item->type=sJSON_String;
-	return ptr;
+	return end;
 }
 
-/* Render the cstring provided to an escaped version that can be printed. */
-static char *print_string_ptr(const char *str) {
+static int is_identifier_char(char c) {
+   return c=='_' || (c>='a' && c<='z') || (c>='A' && c<='Z') || (c>='0' && c<='9');
+}
+
+/* Parse an object key, quoted or an identifier, into the item's name. The key is hashed while it is copied,
+   and with a key table set it is copied to a scratch buffer so a known key needs no allocation. */
+static const char *parse_key(sJSON *item, const char *str) {
+   PROFILE(key);
+   char scratch[256], *out;
    const char *ptr;
-   char *ptr2,*out;
-   int len=0;
+   int len;
+   eastl::MurmurKeyState hash;
+   if (*str=='\"') {
+      len=string_length(str);
+   } else if (*str=='_' || (*str>='a' && *str<='z') || (*str>='A' && *str<='Z')) {
+      for (ptr=str;is_identifier_char(*ptr);ptr++)
+         ;
+      len=(int)(ptr-str);
+   } else {
+      ep=str;      /* not an identifier! */
+      return 0;
+   }
+   sJSONKeyTable *keys = parse_worker ? 0 : sJSON_keys;
+   out = (keys && len<(int)sizeof(scratch)) ? scratch : (char*)sJSON_malloc(len+1);
+   if (!out)
+      return 0;
+
+   eastl::murmurKeyInit(&hash);
+   if (*str=='\"') {
+      ptr=unescape_string(str,out,&hash);
+      if (!ptr) {
+         if (out!=scratch)
+            sJSON_free(out);
+         return 0;
+      }
+   } else {
+      eastl::murmurKeyUpdate(&hash,(const uint8_t*)str,len);
+      memcpy(out,str,len);
+      out[len]=0;
+      ptr=str+len;
+   }
+   item->nameHash=eastl::murmurKeyFinal(&hash);
+   PROFILE_BYTES(key,ptr-str);
+
+   if (!keys) {
+      stats.keyBytes+=len+1;
+      item->nameString=out;
+      return ptr;
+   }
+   item->nameString=intern_key(keys,out,item->nameHash);
+   if (out!=scratch)
+      sJSON_free(out);
+   if (!item->nameString)
+      return 0;
+   item->type|=sJSON_IsInterned;
+   return ptr;
+}
+
+/* Render the cstring provided to an escaped version that can be printed. */
+/* Length of str once escaped, without the quotes. */
+static size_t escaped_length(const char *str) {
+   size_t len=0;
    unsigned char token;
-	
-   if (!str)
-      return sJSON_strdup("");
-   ptr=str;
-   while ((token=*ptr) && ++len) {
-      if (strchr("\"\\\b\f\n\r\t",token))
+   for (;(token=*str);str++,len++) {
+      if (token=='\"' || token=='\\' || token=='\b' || token=='\f' || token=='\n' || token=='\r' || token=='\t')
          len++;
       else if (token<32)
          len+=5;
-      ptr++;
    }
-	
-	out=(char*)sJSON_malloc(len+3);
+   return len;
+}
+/* Write str quoted and escaped to out, which needs escaped_length+2 chars. Returns the end. */
+static char *escape_string(const char *str, char *out) {
+   static const char hex[]="0123456789abcdef";
+   unsigned char token;
+   *out++='\"';
+   while ((token=*str++)) {
+      if (token>31 && token!='\"' && token!='\\') {
+         *out++=token;
+         continue;
+      }
+      *out++='\\';
+      switch (token) {
+         case '\\':	*out++='\\';	break;
+         case '\"':	*out++='\"';	break;
+         case '\b':	*out++='b';	break;
+         case '\f':	*out++='f';	break;
+         case '\n':	*out++='n';	break;
+         case '\r':	*out++='r';	break;
+         case '\t':	*out++='t';	break;
+         default:    /* escape and print */
+            *out++='u';
+            *out++='0';
+            *out++='0';
+            *out++=hex[token>>4];
+            *out++=hex[token&15];
+            break;
+      }
+   }
+   *out++='\"';
+   return out;
+}
+static char *print_string_ptr(const char *str) {
+   PROFILE(printString);
+   char *out;
+   if (!str)
+      return sJSON_strdup("");
+	out=(char*)sJSON_malloc(escaped_length(str)+3);
    if (!out)
       return 0;
-
-	ptr2=out;ptr=str;
-	*ptr2++='\"';
-   while (*ptr) {
-      if ((unsigned char)*ptr>31 && *ptr!='\"' && *ptr!='\\')
-         *ptr2++=*ptr++;
-      else {
-			*ptr2++='\\';
-         switch (token=*ptr++) {
-				case '\\':	*ptr2++='\\';	break;
-				case '\"':	*ptr2++='\"';	break;
-				case '\b':	*ptr2++='b';	break;
-				case '\f':	*ptr2++='f';	break;
-				case '\n':	*ptr2++='n';	break;
-				case '\r':	*ptr2++='r';	break;
-				case '\t':	*ptr2++='t';	break;
-				default: sprintf(ptr2,"u%04x",token);ptr2+=5;	break;	/* escape and print */
-			}
-		}
-	}
-   *ptr2++='\"';
-   *ptr2++=0;
+   *escape_string(str,out)=0;
+   PROFILE_BYTES(printString,strlen(out));
 	return out;
 }
 /* Invote print_string_ptr (which is useful) on an item. */
@@ -309,15 +893,22 @@ static const char *parse_array(sJSON *item,const char *value);
 static const char *parse_object(sJSON *item,const char *value);
 static char *print_value(sJSON *item,int depth,int fmt);
 static char *print_array(sJSON *item,int depth,int fmt);
+static char *print_packed(sJSON *item,int fmt);
 static char *print_object(sJSON *item,int depth,int fmt);
+static int sort_children(sJSON *object);
+static void suffix_object(sJSON *prev, sJSON *item);
 
 
 /* Utility to jump whitespace and cr/lf */
 static const char *skip(const char *in) {
    bool checkAgain;
+   if (!in)
+      return 0;      /* pass on failures */
+   PROFILE(skip);
+   const char *start=in;
    do {
       checkAgain = false;
-      while (in && *in && (unsigned char)*in<=32)
+      while (*in && (unsigned char)*in<=32)
          ++in;
       if(*in && (*in == '/')) {
          if(*(in+1) && (*(in+1) == '/')) {
@@ -329,10 +920,13 @@ static const char *skip(const char *in) {
             checkAgain = true;      //check next line for comments
          } else if(*(in+1) && (*(in+1) == '*')) {
             //find comment end
+            in += 2;
          find_next:
             while(*in && (*in != '*'))
                ++in;
-            if(*(in+1) && *(in+1) != '/') {
+            if(!*in)
+               break;            //unterminated, stop at the end
+            if(*(in+1) != '/') {
                ++in;             //skip *
                goto find_next;
             }
@@ -341,12 +935,235 @@ static const char *skip(const char *in) {
          }
       }
    } while(checkAgain == true);
+   PROFILE_BYTES(skip,in-start);
    return in;
 }
 
+/* Jump over a whole array or object without building it. Strings and comments may contain brackets. */
+static const char *skip_container(const char *in) {
+   int depth=0;
+   while (*in) {
+      switch (*in) {
+         case '[': case '{':
+            depth++;
+            break;
+         case ']': case '}':
+            if (--depth==0)
+               return in+1;
+            break;
+         case '\"':
+            while (*++in!='\"' && *in)
+               if (*in=='\\' && !*++in)
+                  break;
+            if (!*in) {
+               ep=in;      /* unterminated string */
+               return 0;
+            }
+            break;
+         case '/':
+            if (in[1]=='/' || in[1]=='*') {
+               in=skip(in);
+               continue;
+            }
+            break;
+      }
+      in++;
+   }
+   ep=in;      /* unterminated container */
+   return 0;
+}
+
+/* Element i of a packed array. */
+static double packed_value(const sJSON *item, uint32_t i) {
+   switch (item->type&sJSON_PackedMask) {
+      case sJSON_PackedInt32: return ((const int32_t*)item->valueString)[i];
+      case sJSON_PackedInt64: return (double)((const int64_t*)item->valueString)[i];
+      case sJSON_PackedFloat: return ((const float*)item->valueString)[i];
+   }
+   return ((const double*)item->valueString)[i];
+}
+/* Bytes in the buffer of a packed array. */
+static size_t packed_size(const sJSON *item) {
+   int kind=item->type&sJSON_PackedMask;
+   return item->valueInt*(size_t)(kind==sJSON_PackedInt64 || kind==sJSON_PackedDouble ? 8 : 4);
+}
+static int packed_int(double d) {
+   return d>=INT_MIN && d<=INT_MAX ? (int)d : 0;
+}
+
+/* Store n numbers in array as the narrowest packed kind that holds all of them exactly. Takes values. */
+static int pack_values(sJSON *array, double *values, uint32_t n) {
+   int ints=1, longs=1, floats=1, kind;
+   uint32_t i;
+   void *packed=values;
+   for (i=0;i<n;i++) {
+      double d=values[i];
+      ints = ints && d>=INT_MIN && d<=INT_MAX && (double)(int32_t)d==d;
+      longs = longs && d>=-9223372036854775808.0 && d<9223372036854775808.0 && (double)(int64_t)d==d;
+      floats = floats && (fabs(d)<=FLT_MAX ? (double)(float)d==d : isinf(d));
+   }
+   kind = ints ? sJSON_PackedInt32 : floats ? sJSON_PackedFloat : longs ? sJSON_PackedInt64 : sJSON_PackedDouble;
+   if (kind!=sJSON_PackedDouble) {
+      if (!(packed=sJSON_malloc(n*(size_t)(kind==sJSON_PackedInt64 ? 8 : 4)))) {
+         sJSON_free(values);
+         return 0;
+      }
+      for (i=0;i<n;i++) {
+         if (kind==sJSON_PackedInt32)
+            ((int32_t*)packed)[i]=(int32_t)values[i];
+         else if (kind==sJSON_PackedFloat)
+            ((float*)packed)[i]=(float)values[i];
+         else
+            ((int64_t*)packed)[i]=(int64_t)values[i];
+      }
+      sJSON_free(values);
+   }
+   array->type|=sJSON_IsPacked|kind;
+   array->valueString=(char*)packed;
+   array->valueInt=n;
+   return 1;
+}
+
+/* Pack an array whose children are all numbers, as parse_array does with sJSON_ParsePackArrays. */
+static void pack_children(sJSON *array) {
+   uint32_t n=0, i;
+   double *values;
+   sJSON *c;
+   for (c=array->child;c;c=c->next,n++)
+      if ((c->type&255)!=sJSON_Number)
+         return;
+   if (!n || !(values=(double*)sJSON_malloc(n*sizeof(double))))
+      return;
+   for (c=array->child,i=0;c;c=c->next)
+      values[i++]=c->valueDouble;
+   if (pack_values(array,values,n)) {
+      sJSONdelete(array->child);
+      array->child=0;
+   }
+}
+
+/* Give a packed array one child per number again. */
+static int unpack(sJSON *item) {
+   sJSON *first=0, *prev=0, *c;
+   uint32_t i, n=item->valueInt;
+   for (i=0;i<n;i++,prev=c) {
+      if (!(c=sJSON_New_Item())) {
+         sJSONdelete(first);
+         return 0;
+      }
+      c->type=sJSON_Number;
+      c->valueDouble=packed_value(item,i);
+      c->valueInt=packed_int(c->valueDouble);
+      if (prev)
+         suffix_object(prev,c);
+      else
+         first=c;
+   }
+   sJSON_free(item->valueString);
+   item->valueString=0;
+   item->valueInt=0;
+   item->child=first;
+   item->type&=~(sJSON_IsPacked|sJSON_PackedMask);
+   if (journal)
+      journal_materialized(item);
+   return 1;
+}
+
+/* Parse the children of a container that sJSONparseLazy skipped, or unpack a packed array. Child containers
+   stay lazy. A frozen packed array already has its children, next to its buffer. */
+static int materialize(sJSON *item) {
+   const char *source=item->valueString, *value;
+   int lazy=parse_lazy, flags=item->type&~(255|sJSON_IsLazy);
+   if (item->type&sJSON_IsPacked)
+      return (item->type&sJSON_IsFrozen) || unpack(item);
+   if (!(item->type&sJSON_IsLazy))
+      return 1;
+   item->valueString=0;
+   parse_lazy=1;
+   if (*source=='[')
+      value=parse_array(item,source);
+   else
+      value=parse_object(item,skip(*source=='{' ? source+1 : source));
+   parse_lazy=lazy;
+   item->type|=flags;
+   if (!value) {
+      sJSONdelete(item->child);
+      item->child=0;
+      item->type|=sJSON_IsLazy;     /* still only source text */
+      item->valueString=(char*)source;
+      return 0;
+   }
+   if (journal)
+      journal_materialized(item);
+   return 1;
+}
+/* Materialize a container that is about to change, frozen ones can't. Nor can a reference to a frozen
+   container, whose children are still frozen. */
+static int writable(sJSON *item) {
+   return !(item->type&sJSON_IsFrozen) && !(item->child && (item->child->type&sJSON_IsFrozen)) && materialize(item);
+}
+
+/* The first byte of text that isn't part of well formed UTF-8, or 0. Overlong forms, surrogates and code
+   points past 0x10FFFF are rejected. Runs of ASCII are passed over 16 bytes at a time. */
+static const char *invalid_utf8(const char *text, size_t length) {
+   const unsigned char *s=(const unsigned char*)text, *end=s+length;
+   unsigned char lo, hi;
+   int n, i;
+   while (s<end) {
+#ifdef sJSON_SSE2
+      while (end-s>=16 && !_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)s)))
+         s+=16;
+#endif
+      if (s==end)
+         break;
+      if (*s<0x80) {
+         s++;
+         continue;
+      }
+      lo=0x80, hi=0xBF;    /* range of the second byte */
+      if (*s>=0xC2 && *s<=0xDF)
+         n=1;
+      else if (*s>=0xE0 && *s<=0xEF) {
+         n=2;
+         if (*s==0xE0)
+            lo=0xA0;
+         else if (*s==0xED)
+            hi=0x9F;
+      } else if (*s>=0xF0 && *s<=0xF4) {
+         n=3;
+         if (*s==0xF0)
+            lo=0x90;
+         else if (*s==0xF4)
+            hi=0x8F;
+      } else
+         return (const char*)s;
+      if (end-s<=n || s[1]<lo || s[1]>hi)
+         return (const char*)s;
+      for (i=2;i<=n;i++)
+         if ((s[i]&0xC0)!=0x80)
+            return (const char*)s;
+      s+=n+1;
+   }
+   return 0;
+}
+
+int sJSONvalidateUTF8(const char *text, size_t length) {
+   return !invalid_utf8(text,length);
+}
+
+/* With sJSON_ParseValidateUTF8 set, fail on text that isn't UTF-8, pointing ep at the bad byte. */
+static int check_utf8(const char *value, size_t length) {
+   if (!(parse_options&sJSON_ParseValidateUTF8))
+      return 1;
+   ep=invalid_utf8(value,length);
+   return !ep;
+}
+
 /* Parse an object - create a new root, and populate. */
 sJSON *sJSONparse(const char *value) {
 	ep=0;
+   if (!check_utf8(value,strlen(value)))
+      return 0;
 	sJSON *c=sJSON_New_Item();
    if (!c)
       return 0;       /* memory fail */
@@ -366,17 +1183,564 @@ sJSON *sJSONparse(const char *value) {
 	return c;
 }
 
-/* Render a sJSON item/entity/structure to text. */
-char *sJSONprint(sJSON *item)				{
-   return print_value(item,0,1);
+/* Only look at the first token now, children are parsed as they are reached. */
+sJSON *sJSONparseLazy(const char *value) {
+	ep=0;
+   if (!check_utf8(value,strlen(value)))
+      return 0;
+	sJSON *c=sJSON_New_Item();
+   if (!c)
+      return 0;       /* memory fail */
+
+   value = skip(value);
+   c->type = (*value=='[' ? sJSON_Array : sJSON_Object) | sJSON_IsLazy;
+   c->valueString = (char*)value;
+	return c;
 }
-char *sJSONprintUnformatted(sJSON *item)	{
-   return print_value(item,0,0);
+
+/* Find the next document in [in,end): a container, or a braceless sJSON record that runs to the end of its
+   line. Sets *start and returns the end of the document, or 0 if only whitespace and comments are left. */
+static const char *split_document(const char *in, const char *end, const char **start) {
+   int depth=0, bracketed;
+   while (in<end) {
+      if ((unsigned char)*in<=32)
+         in++;
+      else if (*in=='/' && in+1<end && in[1]=='/')
+         while (in<end && *in!=10 && *in!=13)
+            in++;
+      else if (*in=='/' && in+1<end && in[1]=='*') {
+         for (in+=2;in<end && !(*in=='*' && in+1<end && in[1]=='/');in++)
+            ;
+         in = in<end ? in+2 : end;
+      } else
+         break;
+   }
+   if (in>=end)
+      return 0;
+   *start=in;
+   bracketed = (*in=='{' || *in=='[');
+   while (in<end) {
+      switch (*in) {
+         case '[': case '{':
+            depth++;
+            break;
+         case ']': case '}':
+            if (--depth<=0 && bracketed)
+               return in+1;
+            break;
+         case 10: case 13:
+            if (depth<=0 && !bracketed)
+               return in;
+            break;
+         case '\"':
+            for (in++;in<end && *in!='\"';in++)
+               if (*in=='\\')
+                  in++;
+            if (in>=end)
+               return end;
+            break;
+         case '/':
+            if (in+1<end && in[1]=='/') {
+               while (in<end && *in!=10 && *in!=13)
+                  in++;
+               continue;
+            }
+            if (in+1<end && in[1]=='*') {
+               for (in+=2;in<end && !(*in=='*' && in+1<end && in[1]=='/');in++)
+                  ;
+               if (in>=end)
+                  return end;
+               in++;
+            }
+            break;
+      }
+      in++;
+   }
+   return end;
+}
+
+typedef struct sJSONDocument {
+   const char *start, *end;
+   sJSON *item;
+   const char *error;
+} sJSONDocument;
+
+/* Parse documents [first,last), copying each into scratch to terminate it. */
+static void parse_documents(sJSONDocument *doc, sJSONDocument *last, char **scratch, size_t *capacity) {
+   for (;doc<last;doc++) {
+      size_t len=doc->end-doc->start;
+      if (len+1>*capacity) {
+         sJSON_free(*scratch);
+         *capacity=(len+1)*2;
+         if (!(*scratch=(char*)sJSON_malloc(*capacity))) {
+            *capacity=0;
+            doc->error=doc->start;
+            continue;
+         }
+      }
+      memcpy(*scratch,doc->start,len);
+      (*scratch)[len]=0;
+      doc->item=sJSONparse(*scratch);
+      doc->error = doc->item ? 0 : ep ? doc->start+(ep-*scratch) : doc->start;
+   }
+}
+
+uint32_t sJSONparseMany(const char *buf, size_t len, sJSONDocumentCallback callback, void *user) {
+   const uint32_t batch=64;      /* documents claimed by a worker at a time */
+   std::vector<sJSONDocument> docs;
+   const char *in=buf, *end=buf+len, *start;
+   while ((in=split_document(in,end,&start))) {
+      sJSONDocument doc = {start,in,0,0};
+      docs.push_back(doc);
+   }
+   uint32_t count=(uint32_t)docs.size(), batches=(count+batch-1)/batch, delivered=0, b, i;
+   uint32_t threads = parse_threads>0 ? parse_threads : std::thread::hardware_concurrency();
+   if (threads>batches)
+      threads=batches;
+
+   std::mutex lock;
+   std::condition_variable progress;
+   std::vector<char> done(batches,0);
+   std::atomic<uint32_t> next(0);
+   uint32_t window=threads*4;    /* batches parsed ahead of delivery, bounds the memory held */
+   uint32_t deliveredBatches=0;
+   bool stop=false;
+   sJSONWorkerTotals workerTotals;
+   memset(&workerTotals,0,sizeof(workerTotals));
+   std::vector<std::thread> workers;
+   for (i=0;i<threads;i++) {
+      workers.push_back(std::thread([&]() {
+         char *scratch=0;
+         size_t capacity=0;
+         parse_worker=1;
+         for (;;) {
+            uint32_t claim=next++;
+            if (claim>=batches)
+               break;
+            {
+               std::unique_lock<std::mutex> guard(lock);
+               progress.wait(guard,[&]{return stop || claim<deliveredBatches+window;});
+               if (stop)
+                  break;
+            }
+            sJSONDocument *first=&docs[claim*batch];
+            parse_documents(first,first+(claim+1==batches ? count-claim*batch : batch),&scratch,&capacity);
+            std::lock_guard<std::mutex> guard(lock);
+            done[claim]=1;
+            progress.notify_all();
+         }
+         if (scratch)
+            sJSON_free(scratch);
+         std::lock_guard<std::mutex> guard(lock);
+         add_worker_totals(&workerTotals);
+      }));
+   }
+   if (!threads) {   /* nothing to do, or no threads to do it with */
+      char *scratch=0;
+      size_t capacity=0;
+      parse_documents(docs.data(),docs.data()+count,&scratch,&capacity);
+      if (scratch)
+         sJSON_free(scratch);
+      for (b=0;b<batches;b++)
+         done[b]=1;
+   }
+
+   for (b=0;b<batches && !stop;b++) {   /* stop is only written on this thread */
+      {
+         std::unique_lock<std::mutex> guard(lock);
+         progress.wait(guard,[&]{return done[b]!=0;});
+      }
+      for (i=b*batch;i<count && i<(b+1)*batch;i++) {
+         sJSONDocument *doc=&docs[i];
+         ep=doc->error;
+         doc->start=0;     /* delivered, the callback owns the item now */
+         delivered++;
+         if (!callback(doc->item,user)) {
+            std::lock_guard<std::mutex> guard(lock);
+            stop=true;
+            break;
+         }
+      }
+      std::lock_guard<std::mutex> guard(lock);
+      deliveredBatches=b+1;
+      progress.notify_all();
+   }
+   for (i=0;i<workers.size();i++)
+      workers[i].join();
+   take_worker_totals(&workerTotals);
+   for (i=0;i<count;i++)
+      if (docs[i].start)
+         sJSONdelete(docs[i].item);
+   return delivered;
+}
+
+static int first_bit(unsigned mask) {
+#ifdef _MSC_VER
+   unsigned long i;
+   _BitScanForward(&i,mask);
+   return (int)i;
+#else
+   return __builtin_ctz(mask);
+#endif
+}
+
+/* Jump to the next character the structure scan needs outside strings: a bracket, quote, comma or slash. */
+static const char *scan_structural(const char *in, const char *end) {
+#ifdef sJSON_SSE2
+   const __m128i quote=_mm_set1_epi8('\"'), comma=_mm_set1_epi8(','), slash=_mm_set1_epi8('/');
+   const __m128i open=_mm_set1_epi8('{'), close=_mm_set1_epi8('}'), bracketBit=_mm_set1_epi8(0x20);
+   for (;in+16<=end;in+=16) {
+      __m128i v=_mm_loadu_si128((const __m128i*)in);
+      __m128i curly=_mm_or_si128(v,bracketBit);    /* [ and ] become { and } */
+      __m128i hit=_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v,quote),_mm_cmpeq_epi8(v,comma)),
+                               _mm_or_si128(_mm_cmpeq_epi8(v,slash),_mm_or_si128(_mm_cmpeq_epi8(curly,open),_mm_cmpeq_epi8(curly,close))));
+      unsigned mask=(unsigned)_mm_movemask_epi8(hit);
+      if (mask)
+         return in+first_bit(mask);
+   }
+#endif
+   for (;in<end;in++)
+      if (*in=='\"' || *in==',' || *in=='/' || (*in|0x20)=='{' || (*in|0x20)=='}')
+         return in;
+   return end;
+}
+
+/* Return the closing quote of the string whose contents start at in, or end if it is unterminated. */
+static const char *scan_string(const char *in, const char *end) {
+   for (;;) {
+#ifdef sJSON_SSE2
+      const __m128i quote=_mm_set1_epi8('\"'), backslash=_mm_set1_epi8('\\');
+      for (;in+16<=end;in+=16) {
+         __m128i v=_mm_loadu_si128((const __m128i*)in);
+         unsigned mask=(unsigned)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v,quote),_mm_cmpeq_epi8(v,backslash)));
+         if (mask) {
+            in+=first_bit(mask);
+            break;
+         }
+      }
+#endif
+      while (in<end && *in!='\"' && *in!='\\')
+         in++;
+      if (in>=end || *in=='\"')
+         return in<end ? in : end;
+      in+=2;      /* skip the escaped character */
+   }
+}
+
+/* Scan the contents of the root container from in and pick split points about step bytes apart: depth 0
+   commas, and the ends of child containers. Returns the end of the contents, its closing bracket or the end
+   of a braceless root, or 0 if the contents are not simple enough to split. */
+static const char *split_root(const char *in, const char *end, char close, size_t step, std::vector<const char*> &splits) {
+   const char *next=in+step;
+   int depth=0;
+   for (;;) {
+      in=scan_structural(in,end);
+      if (in>=end)
+         return close ? 0 : end;
+      switch (*in) {
+         case '\"':
+            if ((in=scan_string(in+1,end))>=end)
+               return 0;
+            break;
+         case '/':
+            if (in+1<end && in[1]=='/') {
+               while (in<end && *in!=10 && *in!=13)
+                  in++;
+               continue;
+            }
+            if (in+1<end && in[1]=='*') {
+               for (in+=2;in+1<end && !(in[0]=='*' && in[1]=='/');in++)
+                  ;
+               if (in+1>=end)
+                  return 0;
+               in++;
+            }
+            break;
+         case '[': case '{':
+            depth++;
+            break;
+         case ']': case '}':
+            if (depth==0)
+               return *in==(close ? close : '}') ? in : 0;
+            if (--depth==0 && in+1>=next) {
+               splits.push_back(in+1);
+               next=in+1+step;
+            }
+            break;
+         case ',':
+            if (depth==0 && in>=next) {
+               splits.push_back(in);
+               next=in+step;
+            }
+            break;
+      }
+      in++;
+   }
+}
+
+typedef struct sJSONRange {
+   const char *start, *end;
+   sJSON *parsed;    /* a container holding the range's items */
+   int comma;        /* the range started with the comma after the previous item */
+} sJSONRange;
+
+/* Parse a range of the root's items by wrapping a copy of it in open and close. */
+static sJSON *parse_range(sJSONRange *range, char open, char close, char **scratch, size_t *capacity) {
+   const char *start=skip(range->start);
+   if ((range->comma = (start<range->end && *start==',')))
+      start++;
+   if (start>range->end)
+      start=range->end;
+   size_t len=range->end-start;
+   if (len+3>*capacity) {
+      if (*scratch)
+         sJSON_free(*scratch);
+      *capacity=(len+3)*2;
+      if (!(*scratch=(char*)sJSON_malloc(*capacity))) {
+         *capacity=0;
+         return 0;
+      }
+   }
+   (*scratch)[0]=open;
+   memcpy(*scratch+1,start,len);
+   (*scratch)[len+1]=close;
+   (*scratch)[len+2]=0;
+   sJSON *parsed=sJSONparse(*scratch);
+   if (parsed && !materialize(parsed)) {    /* a range of numbers may have been packed */
+      sJSONdelete(parsed);
+      return 0;
+   }
+   return parsed;
+}
+
+/* Give every name below item to the key table, for trees parsed without it. */
+static void intern_names(sJSON *item) {
+   sJSON *c;
+   char *name;
+   for (c=item->child;c;c=c->next) {
+      if (c->nameString && !(c->type&sJSON_IsInterned) && (name=intern_key(sJSON_keys,c->nameString,c->nameHash))) {
+         sJSON_free(c->nameString);
+         c->nameString=name;
+         c->type|=sJSON_IsInterned;
+      }
+      intern_names(c);
+   }
+}
+
+sJSON *sJSONparseParallel(const char *value) {
+   const size_t minimum=1<<20, minimumRange=64<<10;
+   const char *start=skip(value), *end, *close;
+   size_t len=strlen(start);
+   uint32_t threads = parse_threads>0 ? parse_threads : std::thread::hardware_concurrency(), i, count;
+   if (len<minimum || threads<2)
+      return sJSONparse(value);
+
+   char closeChar = *start=='[' ? ']' : *start=='{' ? '}' : 0;
+   char openWrap = *start=='[' ? '[' : '{', closeWrap = *start=='[' ? ']' : '}';
+   size_t pieces=threads*8;
+   if (len/pieces<minimumRange)
+      pieces=len/minimumRange;
+   std::vector<const char*> splits;
+   end=start+len;
+   if (!(close=split_root(closeChar ? start+1 : start,end,closeChar,len/pieces,splits)) || splits.empty())
+      return sJSONparse(value);
+   if (!check_utf8(value,start+len-value))
+      return 0;
+
+   std::vector<sJSONRange> ranges;
+   const char *from = closeChar ? start+1 : start;
+   for (i=0;i<=splits.size();i++) {
+      sJSONRange range = {from, i<splits.size() ? splits[i] : close, 0, 0};
+      ranges.push_back(range);
+      from=range.end;
+   }
+   count=(uint32_t)ranges.size();
+   if (threads>count)
+      threads=count;
+
+   std::atomic<uint32_t> next(0);
+   std::atomic<int> failed(0);
+   auto work=[&]() {
+      char *scratch=0;
+      size_t capacity=0;
+      int worker=parse_worker;
+      parse_worker=1;
+      for (uint32_t claim;(claim=next++)<count && !failed;)
+         if (!(ranges[claim].parsed=parse_range(&ranges[claim],openWrap,closeWrap,&scratch,&capacity)))
+            failed=1;
+      parse_worker=worker;
+      if (scratch)
+         sJSON_free(scratch);
+   };
+   std::mutex statsLock;
+   sJSONWorkerTotals workerTotals;
+   memset(&workerTotals,0,sizeof(workerTotals));
+   std::vector<std::thread> workers;
+   for (i=1;i<threads;i++)
+      workers.push_back(std::thread([&]() {
+         work();
+         std::lock_guard<std::mutex> guard(statsLock);
+         add_worker_totals(&workerTotals);
+      }));
+   work();
+   for (i=0;i<workers.size();i++)
+      workers[i].join();
+   take_worker_totals(&workerTotals);
+
+   /* a comma is only valid after an item and before another one, as sJSONparse checks it */
+   int seen=0;
+   for (i=0;i<count && !failed;i++) {
+      int items = ranges[i].parsed->child!=0;
+      if (ranges[i].comma && (!seen || !items))
+         failed=1;
+      seen|=items;
+   }
+
+   sJSON *root=0, *last=0;
+   if (!failed && (root=sJSON_New_Item()))
+      root->type = openWrap=='[' ? sJSON_Array : sJSON_Object;
+   for (i=0;i<count;i++) {
+      sJSON *parsed=ranges[i].parsed;
+      if (!parsed)
+         continue;
+      if (root && parsed->child) {
+         if (last)
+            suffix_object(last,parsed->child);
+         else
+            root->child=parsed->child;
+         for (last=parsed->child;last->next;last=last->next)
+            ;
+         parsed->child=0;
+      }
+      sJSONdelete(parsed);
+   }
+   if (!root)
+      return sJSONparse(value);
+   if (sJSON_keys && !parse_worker)
+      intern_names(root);
+   if (root->type==sJSON_Object && (parse_options&sJSON_ParseSortObjects) && !sort_children(root)) {
+      sJSONdelete(root);
+      return 0;   /* memory fail */
+   }
+   if (root->type==sJSON_Array && (parse_options&sJSON_ParsePackArrays))
+      pack_children(root);
+   ep=0;
+   return root;
+}
+
+/* Sits just before the text of sJSONmapFile. */
+typedef struct sJSONFileHeader {
+   size_t mapped;    /* bytes mapped, including the header page, or 0 when the file was read into memory */
+} sJSONFileHeader;
+
+static const char *read_file(const char *path, size_t *length) {
+   FILE *f=fopen(path,"rb");
+   sJSONFileHeader *header;
+   long size;
+   if (!f)
+      return 0;
+   if (fseek(f,0,SEEK_END)==0 && (size=ftell(f))>=0 && fseek(f,0,SEEK_SET)==0
+       && (header=(sJSONFileHeader*)sJSON_malloc(sizeof(sJSONFileHeader)+size+1))) {
+      char *text=(char*)(header+1);
+      if (fread(text,1,size,f)==(size_t)size) {
+         fclose(f);
+         header->mapped=0;
+         text[size]=0;
+         *length=size;
+         return text;
+      }
+      sJSON_free(header);
+   }
+   fclose(f);
+   return 0;
+}
+
+const char *sJSONmapFile(const char *path, size_t *length) {
+#ifdef sJSON_MMAP
+   struct stat st;
+   int fd=open(path,O_RDONLY);
+   if (fd<0)
+      return 0;
+   if (fstat(fd,&st)==0 && S_ISREG(st.st_mode) && st.st_size>0) {
+      size_t page=sysconf(_SC_PAGESIZE), size=st.st_size;
+      size_t mapped=page+((size+page)&~(page-1));   /* header page, the file, and at least one zero byte */
+      char *base=(char*)mmap(0,mapped,PROT_READ|PROT_WRITE,MAP_PRIVATE|MAP_ANONYMOUS,-1,0);
+      if (base!=MAP_FAILED) {
+         char *text=base+page;
+         if (mmap(text,size,PROT_READ,MAP_PRIVATE|MAP_FIXED,fd,0)!=MAP_FAILED) {
+            madvise(text,size,MADV_SEQUENTIAL);
+            ((sJSONFileHeader*)text)[-1].mapped=mapped;
+            close(fd);
+            *length=size;
+            return text;
+         }
+         munmap(base,mapped);
+      }
+   }
+   close(fd);
+#endif
+   return read_file(path,length);
+}
+
+void sJSONunmapFile(const char *text) {
+   sJSONFileHeader *header;
+   if (!text)
+      return;
+   header=(sJSONFileHeader*)text-1;
+#ifdef sJSON_MMAP
+   if (header->mapped) {
+      munmap((char*)text-sysconf(_SC_PAGESIZE),header->mapped);
+      return;
+   }
+#endif
+   sJSON_free(header);
+}
+
+/* Touch a page at a time ahead of the parser so the disk reads overlap with parsing. */
+static void prefault(const char *text, size_t length, const std::atomic<bool> *done) {
+   volatile char sink;
+   size_t page=4096, i;
+#ifdef sJSON_MMAP
+   page=sysconf(_SC_PAGESIZE);
+#endif
+   for (i=0;i<length && !*done;i+=page)
+      sink=text[i];
+   (void)sink;
+}
+
+sJSON *sJSONparseFile(const char *path, int flags) {
+   std::atomic<bool> done(false);
+   std::thread reader;
+   size_t length;
+   sJSON *item;
+   const char *text=sJSONmapFile(path,&length);
+   if (!text) {
+      ep=0;
+      return 0;
+   }
+   if ((flags&sJSON_FilePrefault) && ((sJSONFileHeader*)text)[-1].mapped)
+      reader=std::thread(prefault,text,length,&done);
+   item = flags&sJSON_FileParallel ? sJSONparseParallel(text) : sJSONparse(text);
+   done=true;
+   if (reader.joinable())
+      reader.join();
+   sJSONunmapFile(text);
+   ep=0;    /* the text is gone */
+   return item;
+}
+
+/* Render a sJSON item/entity/structure to text. */
+char *sJSONprint(sJSON *item)				{
+   return print_value(item,0,1);
+}
+char *sJSONprintUnformatted(sJSON *item)	{
+   return print_value(item,0,0);
 }
 
 
 /* Parser core - when encountering text, process appropriately. */
 static const char *parse_value(sJSON *item,const char *value) {
+   PROFILE(parse);
    if (!value)
       return 0;	/* Fail on null. */
    if (!strncmp(value,"null",4))	{
@@ -394,6 +1758,11 @@ static const char *parse_value(sJSON *item,const char *value) {
    }
    if (*value=='-' || (*value>='0' && *value<='9'))
       return parse_number(item,value);
+   if (parse_lazy && (*value=='[' || *value=='{')) {
+      item->type = (*value=='[' ? sJSON_Array : sJSON_Object) | sJSON_IsLazy;
+      item->valueString = (char*)value;
+      return skip_container(value);
+   }
    if (*value=='[')
       return parse_array(item,value);
    if (*value=='{') {
@@ -408,8 +1777,11 @@ static const char *parse_value(sJSON *item,const char *value) {
 
 /* Render a value to text. */
 static char *print_value(sJSON *item,int depth,int fmt) {
+   PROFILE(print);
    char *out=0;
-   if (!item)
+   if (item && (item->type&sJSON_IsPacked))
+      return print_packed(item,fmt);
+   if (!item || !materialize(item))
       return 0;
    switch ((item->type)&255) {
       case sJSON_NULL:   out=sJSON_strdup("null");	break;
@@ -424,9 +1796,38 @@ static char *print_value(sJSON *item,int depth,int fmt) {
 }
 
 
+/* Parse an array of numbers straight into a packed buffer. Returns 0, leaving item alone, at anything else. */
+static const char *parse_packed(sJSON *item,const char *value) {
+   sJSON number;
+   double *values=0, *grown;
+   uint32_t n=0, capacity=0;
+   while (*value=='-' || (*value>='0' && *value<='9')) {
+      if (n==capacity) {
+         capacity = capacity ? capacity*2 : 16;
+         if (!(grown=(double*)sJSON_malloc(capacity*sizeof(double))))
+            break;
+         if (values) {
+            memcpy(grown,values,n*sizeof(double));
+            sJSON_free(values);
+         }
+         values=grown;
+      }
+      value=skip(parse_number(&number,value));
+      values[n++]=number.valueDouble;
+      if (*value==']')
+         return pack_values(item,values,n) ? value+1 : 0;
+      if (*value==',')
+         value=skip(value+1);
+   }
+   if (values)
+      sJSON_free(values);
+   return 0;
+}
+
 /* Build an array from input text. */
 static const char *parse_array(sJSON *item,const char *value) {
 	sJSON *child;
+   const char *packed;
    if (*value!='[')	{  /* not an array! */
       ep=value;
       return 0;
@@ -436,6 +1837,8 @@ static const char *parse_array(sJSON *item,const char *value) {
    value = skip(value+1);
    if (*value == ']')     /* empty array. */
       return value+1;
+   if ((parse_options&sJSON_ParsePackArrays) && !parse_lazy && (packed=parse_packed(item,value)))
+      return packed;     /* not when materializing, which wants the children */
 
    item->child = child = sJSON_New_Item();
    if (!item->child) /* memory fail */
@@ -532,9 +1935,116 @@ static char *print_array(sJSON *item,int depth,int fmt) {
    return out;
 }
 
+/* Render a packed array, as print_array would its children. The speed comes from one buffer for the whole
+   array and the two digit table of format_int, with no node or string per element; the digits of each number
+   depend on its length, so there is nothing to gain from SSE2 here as there is in the scanners. */
+static char *print_packed(sJSON *item,int fmt) {
+   int kind=item->type&sJSON_PackedMask;
+   uint32_t n=item->valueInt, i;
+   size_t room = kind==sJSON_PackedInt32 ? 14 : 330;   /* widest number, a separator and the closing bracket */
+   size_t size=(size_t)n*(kind==sJSON_PackedInt32 ? 13 : 24)+8, len=1;
+   char *out=(char*)sJSON_malloc(size), *grown;
+   double d;
+   if (!out)
+      return 0;
+   *out='[';
+   for (i=0;i<n;i++) {
+      if (size-len<room) {
+         if (!(grown=(char*)sJSON_malloc(size*2))) {
+            sJSON_free(out);
+            return 0;
+         }
+         memcpy(grown,out,len);
+         sJSON_free(out);
+         out=grown;
+         size*=2;
+      }
+      if (i) {
+         out[len++]=',';
+         if (fmt)
+            out[len++]=' ';
+      }
+      if (kind==sJSON_PackedInt32) {
+         len+=format_int(out+len,((const int32_t*)item->valueString)[i]);
+      } else {
+         d=packed_value(item,i);
+         len+=format_number(out+len,packed_int(d),d);
+      }
+   }
+   out[len++]=']';
+   out[len]=0;
+   return out;
+}
+
+/* Stable merge sort of an object's children by nameHash, so duplicate keys keep their order. */
+static void sort_by_hash(sJSON **items, sJSON **tmp, uint32_t n) {
+   uint32_t width, i, a, b, k, mid, end;
+   for (width=1;width<n;width*=2) {
+      for (i=0;i<n;i+=2*width) {
+         mid = i+width<n ? i+width : n;
+         end = i+2*width<n ? i+2*width : n;
+         for (a=i,b=mid,k=i;k<end;k++)
+            tmp[k] = (b>=end || (a<mid && items[a]->nameHash<=items[b]->nameHash)) ? items[a++] : items[b++];
+      }
+      memcpy(items,tmp,n*sizeof(sJSON*));
+   }
+}
+
+/* Put the children of an object in nameHash order and keep an array of them in valueString. */
+static int sort_children(sJSON *object) {
+   uint32_t n=0, i;
+   sJSON *c, **index, **tmp;
+   for (c=object->child;c;c=c->next)
+      n++;
+   if (object->type&sJSON_IsSorted)
+      sJSON_free(object->valueString);
+   object->valueString=0;
+   object->valueInt=0;
+   object->type&=~sJSON_IsSorted;
+   if (!n) {
+      object->type|=sJSON_IsReordered;
+      return 1;
+   }
+   index=(sJSON**)sJSON_malloc(n*sizeof(sJSON*));
+   tmp=(sJSON**)sJSON_malloc(n*sizeof(sJSON*));
+   if (!index || !tmp) {
+      if (index)
+         sJSON_free(index);
+      if (tmp)
+         sJSON_free(tmp);
+      return 0;
+   }
+   for (c=object->child,i=0;c;c=c->next)
+      index[i++]=c;
+   sort_by_hash(index,tmp,n);
+   sJSON_free(tmp);
+
+   object->child=index[0];
+   for (i=0;i<n;i++) {
+      index[i]->prev = i ? index[i-1] : 0;
+      index[i]->next = i+1<n ? index[i+1] : 0;
+   }
+   object->valueString=(char*)index;
+   object->valueInt=n;
+   object->type|=sJSON_IsSorted|sJSON_IsReordered;
+   return 1;
+}
+
+/* Changing the children of a sorted object keeps their order but drops the index. sJSON_IsReordered stays. */
+static void drop_index(sJSON *object) {
+   if (!(object->type&sJSON_IsSorted))
+      return;
+   if (!(object->type&sJSON_IsReference))
+      sJSON_free(object->valueString);
+   object->valueString=0;
+   object->valueInt=0;
+   object->type&=~sJSON_IsSorted;
+}
+
 /* Build an object from the text. */
 static const char *parse_object(sJSON *item,const char *value) {
 	sJSON *child;
+   int nameFlags;
 //   if (*value!='{')	{     /* not an object! */
 //      ep=value;
 //      return 0;
@@ -548,17 +2058,16 @@ static const char *parse_object(sJSON *item,const char *value) {
 	item->child=child=sJSON_New_Item();
    if (!item->child)
       return 0;
-   value=skip(parse_string_or_identifier(child,skip(value)));
+   value=skip(parse_key(child,skip(value)));
    if (!value)
       return 0;
-   child->nameHash = eastl::murmurString(child->valueString);
-   child->nameString = child->valueString;
-   child->valueString = 0;
    if ((*value != ':') && (*value != '=')) {
       ep=value;      /* fail! */
       return 0;
    }
+   nameFlags = child->type&sJSON_IsInterned;
 	value=skip(parse_value(child,skip(value+1)));	/* skip any spacing, get the value. */
+   child->type |= nameFlags;
    if (!value)
       return 0;
 	
@@ -570,23 +2079,24 @@ static const char *parse_object(sJSON *item,const char *value) {
       new_item->prev=child;
       child=new_item;
       if(*value == ',')
-         value=skip(parse_string_or_identifier(child,skip(value+1)));
+         value=skip(parse_key(child,skip(value+1)));
       else
-         value=skip(parse_string_or_identifier(child,skip(value)));
+         value=skip(parse_key(child,skip(value)));
       if (!value)
          return 0;
-      child->nameHash = eastl::murmurString(child->valueString);
-      child->nameString=child->valueString;
-      child->valueString=0;
       if ((*value!=':') && (*value!='=')) {
          ep=value;   	/* fail! */
          return 0;
       }
+      nameFlags = child->type&sJSON_IsInterned;
 		value=skip(parse_value(child,skip(value+1)));	/* skip any spacing, get the value. */
+      child->type |= nameFlags;
       if (!value)
          return 0;
 	}
 
+   if((*value == 0 || *value == '}') && (parse_options&sJSON_ParseSortObjects) && !sort_children(item))
+      return 0;   /* memory fail */
    if(*value == 0)   //file end
       return value;
    if(*value == '}')
@@ -684,8 +2194,329 @@ static char *print_object(sJSON *item,int depth,int fmt) {
    return out;
 }
 
+/* Streaming writer. Bit n of arrays, started and keyed describes the container n levels down; keyed is set
+   while an object's key waits for its value. */
+void sJSONwriterInit(sJSONWriter *w, char *buffer, size_t capacity, int flags) {
+   memset(w,0,sizeof(sJSONWriter));
+   w->buffer=buffer;
+   w->capacity = buffer ? capacity : 0;
+   w->owned = !buffer;
+   w->flags=flags;
+}
+
+char *sJSONwriterFinish(sJSONWriter *w, size_t *length) {
+   if (w->depth || !w->length)
+      w->failed=1;
+   if (w->failed || (!w->owned && w->length>=w->capacity)) {
+      if (w->owned)
+         sJSON_free(w->buffer);
+      w->buffer=0;
+      return 0;
+   }
+   w->buffer[w->length]=0;
+   if (length)
+      *length=w->length;
+   return w->buffer;
+}
+
+/* Make room for n more chars and the terminator. */
+static int writer_reserve(sJSONWriter *w, size_t n) {
+   size_t capacity;
+   char *grown;
+   if (w->failed)
+      return 0;
+   if (w->length+n<w->capacity)
+      return 1;
+   if (!w->owned) {
+      w->failed=1;
+      return 0;
+   }
+   for (capacity = w->capacity ? w->capacity*2 : 256;capacity<=w->length+n;capacity*=2)
+      ;
+   if (!(grown=(char*)sJSON_malloc(capacity))) {
+      w->failed=1;
+      return 0;
+   }
+   if (w->buffer) {
+      memcpy(grown,w->buffer,w->length);
+      sJSON_free(w->buffer);
+   }
+   w->buffer=grown;
+   w->capacity=capacity;
+   return 1;
+}
+static void writer_put(sJSONWriter *w, const char *str, size_t n) {
+   if (writer_reserve(w,n)) {
+      memcpy(w->buffer+w->length,str,n);
+      w->length+=n;
+   }
+}
+static void writer_tabs(sJSONWriter *w, int n) {
+   if (writer_reserve(w,n)) {
+      memset(w->buffer+w->length,'\t',n);
+      w->length+=n;
+   }
+}
+
+/* Separate a value from the one before it in an array. Values in objects follow their key, and the root
+   holds one value. */
+static void writer_value(sJSONWriter *w) {
+   uint64_t bit;
+   if (!w->depth) {
+      if (w->length)
+         w->failed=1;
+      return;
+   }
+   bit=(uint64_t)1<<(w->depth-1);
+   if (!(w->arrays&bit)) {
+      if (!(w->keyed&bit))
+         w->failed=1;
+      w->keyed&=~bit;
+      return;
+   }
+   if (w->started&bit) {
+      const char *sep = (w->flags&sJSON_WriteDialect) ? " " : (w->flags&sJSON_WriteFormatted) ? ", " : ",";
+      writer_put(w,sep,strlen(sep));
+   }
+   w->started|=bit;
+}
+
+static void writer_open(sJSONWriter *w, char open, int array) {
+   writer_value(w);
+   if (w->depth>=64) {
+      w->failed=1;
+      return;
+   }
+   writer_put(w,&open,1);
+   if (!array && (w->flags&sJSON_WriteFormatted))
+      writer_put(w,"\n",1);
+   w->arrays = array ? w->arrays|((uint64_t)1<<w->depth) : w->arrays&~((uint64_t)1<<w->depth);
+   w->started&=~((uint64_t)1<<w->depth);
+   w->keyed&=~((uint64_t)1<<w->depth);
+   w->depth++;
+}
+
+static void writer_close(sJSONWriter *w, char close, int array) {
+   uint64_t bit;
+   if (!w->depth || !(w->arrays&((uint64_t)1<<(w->depth-1)))!=!array || (w->keyed&((uint64_t)1<<(w->depth-1)))) {
+      w->failed=1;
+      return;
+   }
+   bit=(uint64_t)1<<--w->depth;
+   if (!array && (w->flags&sJSON_WriteFormatted)) {
+      if (w->started&bit)
+         writer_put(w,"\n",1);
+      writer_tabs(w,w->depth);
+   }
+   writer_put(w,&close,1);
+}
+
+void sJSONwriteBeginObject(sJSONWriter *w) {writer_open(w,'{',0);}
+void sJSONwriteEndObject(sJSONWriter *w) {writer_close(w,'}',0);}
+void sJSONwriteBeginArray(sJSONWriter *w) {writer_open(w,'[',1);}
+void sJSONwriteEndArray(sJSONWriter *w) {writer_close(w,']',1);}
+
+void sJSONwriteKey(sJSONWriter *w, const char *name) {
+   uint64_t bit=(uint64_t)1<<(w->depth>0 ? w->depth-1 : 0);
+   int fmt=w->flags&sJSON_WriteFormatted, dialect=w->flags&sJSON_WriteDialect;
+   const char *ptr=name;
+   if (!w->depth || (w->arrays&bit) || (w->keyed&bit) || !name) {
+      w->failed=1;
+      return;
+   }
+   w->keyed|=bit;
+   if (w->started&bit) {
+      if (!dialect)
+         writer_put(w,",",1);
+      if (fmt || dialect)
+         writer_put(w,fmt ? "\n" : " ",1);
+   }
+   w->started|=bit;
+   if (fmt)
+      writer_tabs(w,w->depth);
+   if (dialect && (*ptr=='_' || (*ptr>='a' && *ptr<='z') || (*ptr>='A' && *ptr<='Z')))
+      while (is_identifier_char(*ptr))
+         ptr++;
+   if (ptr!=name && !*ptr) {
+      writer_put(w,name,ptr-name);
+   } else if (writer_reserve(w,escaped_length(name)+2)) {
+      w->length=escape_string(name,w->buffer+w->length)-w->buffer;
+   }
+   ptr = dialect ? (fmt ? " = " : "=") : (fmt ? ":\t" : ":");
+   writer_put(w,ptr,strlen(ptr));
+}
+
+void sJSONwriteNumber(sJSONWriter *w, double num) {
+   char str[320];
+   writer_value(w);
+   writer_put(w,str,format_number(str,packed_int(num),num));
+}
+void sJSONwriteString(sJSONWriter *w, const char *string) {
+   writer_value(w);
+   if (!string)
+      string="";
+   if (writer_reserve(w,escaped_length(string)+2))
+      w->length=escape_string(string,w->buffer+w->length)-w->buffer;
+}
+void sJSONwriteBool(sJSONWriter *w, int b) {
+   writer_value(w);
+   writer_put(w,b ? "true" : "false",b ? 4 : 5);
+}
+void sJSONwriteNull(sJSONWriter *w) {
+   writer_value(w);
+   writer_put(w,"null",4);
+}
+
+/* Minifier output, which stops taking chars once it is full. limit leaves room for the terminator. */
+typedef struct sJSONMinifyOut {
+   char *ptr, *limit;
+   int full;
+} sJSONMinifyOut;
+static void minify_put(sJSONMinifyOut *o, const char *str, size_t n) {
+   if ((size_t)(o->limit-o->ptr)<n) {
+      o->full=1;
+      return;
+   }
+   memmove(o->ptr,str,n);     /* out may be the input */
+   o->ptr+=n;
+}
+
+/* Chars of a bare token: identifiers, numbers and literals. */
+static int is_token_char(char c) {
+   return is_identifier_char(c) || c=='-' || c=='+' || c=='.';
+}
+
+/* Jump whitespace and comments like skip, within [in,end). Returns 0 at an unterminated block comment. */
+static const char *skip_gap(const char *in, const char *end) {
+   const char *close;
+   for (;;) {
+      while (in<end && (unsigned char)*in<=32)
+         in++;
+      if (end-in<2 || in[0]!='/')
+         return in;
+      if (in[1]=='/') {
+         while (in<end && *in!=10 && *in!=13)
+            in++;
+      } else if (in[1]=='*') {
+         for (close=in+2;(close=(const char*)memchr(close,'*',end-close)) && close+1<end && close[1]!='/';close++)
+            ;
+         if (!close || close+1>=end) {
+            ep=in;
+            return 0;
+         }
+         in=close+2;
+      } else
+         return in;
+   }
+}
+
+size_t sJSONminify(const char *in, size_t length, char *out, size_t capacity, int flags) {
+   const char *end=in+length, *token;
+   sJSONMinifyOut o = {out, out+(capacity ? capacity-1 : 0), !capacity};
+   std::vector<char> open;    /* brackets of the containers we are in */
+   int strict=flags&sJSON_MinifyStrict;
+   int value=0;      /* the last token was a value or key, so strict output needs a comma before the next */
+   int colon=0;      /* the last token was a colon, so an object member's value comes next */
+   int braceless=0, gap, key;
+   char c;
+   ep=0;
+   if (!(in=skip_gap(in,end)))
+      return 0;
+   if (strict && (in==end || (*in!='{' && *in!='['))) {
+      braceless=1;
+      open.push_back('{');
+      minify_put(&o,"{",1);
+   }
+   while (!o.full) {
+      if (!(token=skip_gap(in,end)))
+         return 0;
+      gap = token!=in;
+      if ((in=token)==end)
+         break;
+      c=*in;
+      if (c==',') {
+         minify_put(&o,in++,1);
+         value=colon=0;
+         continue;
+      }
+      if (c==':' || c=='=') {
+         minify_put(&o,strict ? ":" : in,1);
+         in++;
+         value=0;
+         colon=1;
+         continue;
+      }
+      if (c=='}' || c==']') {
+         if (open.empty() || open.back()!=(c=='}' ? '{' : '[') || (braceless && open.size()==1)) {
+            ep=in;
+            return 0;
+         }
+         if (strict && o.ptr>out && o.ptr[-1]==',')
+            o.ptr--;    /* a trailing comma */
+         open.pop_back();
+         minify_put(&o,in++,1);
+         value=1;
+         colon=0;
+         continue;
+      }
+
+      /* a key or value starts here */
+      key = !open.empty() && open.back()=='{' && !colon;
+      if (strict && value)
+         minify_put(&o,",",1);
+      else if (!strict && gap && o.ptr>out && is_token_char(o.ptr[-1]) && is_token_char(c))
+         minify_put(&o," ",1);     /* "1 2" must not become "12" */
+      value=1;
+      colon=0;
+      if (c=='{' || c=='[') {
+         open.push_back(c);
+         minify_put(&o,in++,1);
+         value=0;
+      } else if (c=='\"') {
+         if ((token=scan_string(in+1,end))==end) {
+            ep=in;
+            return 0;
+         }
+         minify_put(&o,in,token+1-in);
+         in=token+1;
+      } else {
+         for (token=in;token<end && is_token_char(*token);token++)
+            ;
+         if (token==in)
+            token++;    /* anything else passes through */
+         if (strict && key) {
+            minify_put(&o,"\"",1);
+            minify_put(&o,in,token-in);
+            minify_put(&o,"\"",1);
+         } else
+            minify_put(&o,in,token-in);
+         in=token;
+      }
+   }
+   if (braceless) {
+      if (o.ptr>out && o.ptr[-1]==',')
+         o.ptr--;
+      open.pop_back();
+      minify_put(&o,"}",1);
+   }
+   if (strict && !open.empty()) {
+      ep=end;     /* unclosed */
+      return 0;
+   }
+   if (o.full)
+      return 0;
+   *o.ptr=0;
+   return o.ptr-out;
+}
+
 /* Get Array size/item / object item. */
 uint32_t sJSONgetArraySize(sJSON *array) {
+   if (array->type&sJSON_IsPacked)
+      return array->valueInt;
+   if (!materialize(array))
+      return 0;
+   if (array->type&sJSON_IsSorted)
+      return array->valueInt;
    sJSON *c=array->child;
    int i=0;
    while(c) {
@@ -695,6 +2526,10 @@ uint32_t sJSONgetArraySize(sJSON *array) {
    return i;
 }
 sJSON *sJSONgetArrayItem(sJSON *array,int item) {
+   if (!materialize(array))
+      return 0;
+   if (array->type&sJSON_IsSorted)
+      return (item>=0 && item<array->valueInt) ? ((sJSON**)array->valueString)[item] : 0;
    sJSON *c=array->child;
    while (c && item>0) {
       item--;
@@ -702,12 +2537,372 @@ sJSON *sJSONgetArrayItem(sJSON *array,int item) {
    }
    return c;
 }
+
+/* Conversions for the sJSONget*Array functions. Integers saturate at the limits of their type, NaN is 0. */
+static float convert_number(double d, float*) {return (float)d;}
+static double convert_number(double d, double*) {return d;}
+static int convert_number(double d, int*) {
+   if (d>=INT_MIN && d<=INT_MAX)
+      return (int)d;
+   return d<0 ? INT_MIN : d>0 ? INT_MAX : 0;
+}
+static int64_t convert_number(double d, int64_t*) {
+   if (d>=-9223372036854775808.0 && d<9223372036854775808.0)
+      return (int64_t)d;
+   return d<0 ? INT64_MIN : d>0 ? INT64_MAX : 0;
+}
+
+/* Copy the first n elements of a packed array, converting 4 or 2 at a time where SSE2 can. */
+static void copy_packed(const sJSON *array, float *out, uint32_t n) {
+   const void *src=array->valueString;
+   uint32_t i=0;
+   switch (array->type&sJSON_PackedMask) {
+      case sJSON_PackedFloat:
+         memcpy(out,src,n*sizeof(float));
+         return;
+#ifdef sJSON_SSE2
+      case sJSON_PackedInt32:
+         for (;i+4<=n;i+=4)
+            _mm_storeu_ps(out+i,_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)((const int32_t*)src+i))));
+         break;
+      case sJSON_PackedDouble:
+         for (;i+4<=n;i+=4)
+            _mm_storeu_ps(out+i,_mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd((const double*)src+i)),
+                                              _mm_cvtpd_ps(_mm_loadu_pd((const double*)src+i+2))));
+         break;
+#endif
+   }
+   for (;i<n;i++)
+      out[i]=(float)packed_value(array,i);
+}
+static void copy_packed(const sJSON *array, double *out, uint32_t n) {
+   const void *src=array->valueString;
+   uint32_t i=0;
+   switch (array->type&sJSON_PackedMask) {
+      case sJSON_PackedDouble:
+         memcpy(out,src,n*sizeof(double));
+         return;
+#ifdef sJSON_SSE2
+      case sJSON_PackedInt32:
+         for (;i+2<=n;i+=2)
+            _mm_storeu_pd(out+i,_mm_cvtepi32_pd(_mm_loadl_epi64((const __m128i*)((const int32_t*)src+i))));
+         break;
+      case sJSON_PackedFloat:
+         for (;i+2<=n;i+=2)
+            _mm_storeu_pd(out+i,_mm_cvtps_pd(_mm_castpd_ps(_mm_load_sd((const double*)((const float*)src+i)))));
+         break;
+#endif
+   }
+   for (;i<n;i++)
+      out[i]=packed_value(array,i);
+}
+static void copy_packed(const sJSON *array, int *out, uint32_t n) {
+   uint32_t i;
+   if ((array->type&sJSON_PackedMask)==sJSON_PackedInt32) {
+      memcpy(out,array->valueString,n*sizeof(int));
+      return;
+   }
+   for (i=0;i<n;i++)
+      out[i]=convert_number(packed_value(array,i),out);
+}
+static void copy_packed(const sJSON *array, int64_t *out, uint32_t n) {
+   uint32_t i;
+   switch (array->type&sJSON_PackedMask) {
+      case sJSON_PackedInt64:
+         memcpy(out,array->valueString,n*sizeof(int64_t));
+         break;
+      case sJSON_PackedInt32:
+         for (i=0;i<n;i++)
+            out[i]=((const int32_t*)array->valueString)[i];
+         break;
+      default:
+         for (i=0;i<n;i++)
+            out[i]=convert_number(packed_value(array,i),out);
+   }
+}
+
+template<typename T> static int get_numbers(sJSON *array, T *out, int capacity) {
+   sJSON *c;
+   int n=0;
+   if (capacity<0)
+      capacity=0;
+   if (!array || (array->type&255)!=sJSON_Array)
+      return -1;
+   if (array->type&sJSON_IsPacked) {
+      n=array->valueInt;
+      copy_packed(array,out,n<capacity ? n : capacity);
+      return n;
+   }
+   if (!materialize(array))
+      return -1;
+   for (c=array->child;c;c=c->next,n++) {
+      if ((c->type&255)!=sJSON_Number)
+         return -1;
+      if (n<capacity)
+         out[n]=convert_number(c->valueDouble,out);
+   }
+   return n;
+}
+int sJSONgetIntArray(sJSON *array,int *numbers,int capacity) {return get_numbers(array,numbers,capacity);}
+int sJSONgetInt64Array(sJSON *array,int64_t *numbers,int capacity) {return get_numbers(array,numbers,capacity);}
+int sJSONgetFloatArray(sJSON *array,float *numbers,int capacity) {return get_numbers(array,numbers,capacity);}
+int sJSONgetDoubleArray(sJSON *array,double *numbers,int capacity) {return get_numbers(array,numbers,capacity);}
+
+/* sJSONparseInto: the grammar of parse_object and parse_value, writing known fields and skipping the rest. */
+static int field_matches(const sJSONField *field, eastl::murmur_hash_t hash, const char *name) {
+   if (field->key.mHash!=hash)
+      return 0;
+   if (field->key.mStr)
+      return !strcmp(field->key.mStr,name);
+#ifdef EASTL_MURMUR_HASH_64
+   return 1;   /* a 64bit hash is trusted alone, as in compareNames */
+#else
+   return 0;
+#endif
+}
+
+/* Find the field for a key, trying the one after the last match first as keys tend to come in order. */
+static const sJSONField *find_field(const sJSONField *fields, const sJSONField **next, eastl::murmur_hash_t hash, const char *name) {
+   const sJSONField *f=*next, *start;
+   if (!f->type)
+      f=fields;
+   if (!f->type)
+      return 0;
+   start=f;
+   do {
+      if (field_matches(f,hash,name)) {
+         *next=f+1;
+         return f;
+      }
+      if (!(++f)->type)
+         f=fields;
+   } while (f!=start);
+   return 0;
+}
+
+/* Read a key like parse_key, into scratch when it fits, and find its field or NULL. */
+static const char *parse_field_key(const char *str, const sJSONField *fields, const sJSONField **next, const sJSONField **field) {
+   char scratch[256], *name;
+   const char *ptr;
+   int len;
+   eastl::MurmurKeyState hash;
+   if (*str=='\"') {
+      len=string_length(str);
+   } else if (*str=='_' || (*str>='a' && *str<='z') || (*str>='A' && *str<='Z')) {
+      for (ptr=str;is_identifier_char(*ptr);ptr++)
+         ;
+      len=(int)(ptr-str);
+   } else {
+      ep=str;      /* not an identifier! */
+      return 0;
+   }
+   name = len<(int)sizeof(scratch) ? scratch : (char*)sJSON_malloc(len+1);
+   if (!name)
+      return 0;
+   eastl::murmurKeyInit(&hash);
+   if (*str=='\"') {
+      ptr=unescape_string(str,name,&hash);
+   } else {
+      eastl::murmurKeyUpdate(&hash,(const uint8_t*)str,len);
+      memcpy(name,str,len);
+      name[len]=0;
+      ptr=str+len;
+   }
+   *field=find_field(fields,next,eastl::murmurKeyFinal(&hash),name);
+   if (name!=scratch)
+      sJSON_free(name);
+   return ptr;
+}
+
+/* Unescape a string into a char array of size bytes, cutting it short if it doesn't fit. */
+static const char *copy_string(const char *str, char *out, size_t size) {
+   char scratch[256], *copy;
+   size_t len=string_length(str);
+   if (len<size)
+      return unescape_string(str,out,0);
+   copy = len<sizeof(scratch) ? scratch : (char*)sJSON_malloc(len+1);
+   if (!copy)
+      return 0;
+   str=unescape_string(str,copy,0);
+   len=strlen(copy);
+   if (len>=size)
+      len=size-1;
+   memcpy(out,copy,len);
+   out[len]=0;
+   if (copy!=scratch)
+      sJSON_free(copy);
+   return str;
+}
+
+static const char *skip_string(const char *str) {
+   while (*++str!='\"' && *str)
+      if (*str=='\\' && !*++str)
+         break;
+   return *str ? str+1 : str;
+}
+
+static void store_number(const sJSONField *field, char *out, double d) {
+   out+=field->offset;
+   switch (field->type) {
+      case sJSON_FieldInt:    *(int*)out=convert_number(d,(int*)0); break;
+      case sJSON_FieldInt64:  *(int64_t*)out=convert_number(d,(int64_t*)0); break;
+      case sJSON_FieldFloat:  *(float*)out=(float)d; break;
+      case sJSON_FieldDouble: *(double*)out=d; break;
+   }
+}
+
+static const char *parse_into(const char *value, const sJSONField *fields, char *out);
+static const char *parse_field_value(const char *value, const sJSONField *field, char *out) {
+   sJSON number;
+   int type = field ? field->type : 0;
+   if (*value=='{' && type==sJSON_FieldObject)
+      return parse_into(skip(value+1),field->fields,out+field->offset);
+   if (*value=='{' || *value=='[')
+      return skip_container(value);
+   if (*value=='\"')
+      return type==sJSON_FieldString && field->size ? copy_string(value,out+field->offset,field->size) : skip_string(value);
+   if (!strncmp(value,"true",4) || !strncmp(value,"false",5)) {
+      if (type==sJSON_FieldBool)
+         *(int*)(out+field->offset) = *value=='t';
+      return value + (*value=='t' ? 4 : 5);
+   }
+   if (!strncmp(value,"null",4))
+      return value+4;
+   if (*value=='-' || (*value>='0' && *value<='9')) {
+      value=parse_number(&number,value);
+      if (field)
+         store_number(field,out,number.valueDouble);
+      return value;
+   }
+   ep=value;
+   return 0;	/* failure. */
+}
+
+static const char *parse_into(const char *value, const sJSONField *fields, char *out) {
+   const sJSONField *next=fields, *field;
+   int first=1;
+   while (*value && *value!='}') {
+      if (!first && *value==',')
+         value=skip(value+1);
+      first=0;
+      value=skip(parse_field_key(value,fields,&next,&field));
+      if (!value)
+         return 0;
+      if ((*value!=':') && (*value!='=')) {
+         ep=value;      /* fail! */
+         return 0;
+      }
+      value=skip(parse_field_value(skip(value+1),field,out));
+      if (!value)
+         return 0;
+   }
+   return *value ? value+1 : value;
+}
+
+int sJSONparseInto(const char *value, const sJSONField *fields, void *out) {
+   ep=0;
+   value=skip(value);
+   if (*value=='[') {
+      ep=value;      /* not an object! */
+      return 0;
+   }
+   if (*value=='{')
+      value=skip(value+1);
+   return parse_into(value,fields,(char*)out)!=0;
+}
+
+/* Binary search the index of a sorted object for the first child with the hash, then check names. */
+static sJSON *find_sorted(sJSON *object, eastl::FixedMurmurHash stringHash) {
+   sJSON **index=(sJSON**)object->valueString;
+   uint32_t lo=0, hi=object->valueInt, mid;
+   while (lo<hi) {
+      mid=(lo+hi)/2;
+      if (index[mid]->nameHash<stringHash.mHash)
+         lo=mid+1;
+      else
+         hi=mid;
+   }
+   for (;lo<(uint32_t)object->valueInt && index[lo]->nameHash==stringHash.mHash;lo++)
+      if (!compareNames(index[lo],stringHash))
+         return index[lo];
+   return 0;
+}
 sJSON *sJSONgetObjectItem(sJSON *object, eastl::FixedMurmurHash stringHash) {
+   if (!materialize(object))
+      return 0;
+   if (object->type&sJSON_IsSorted)
+      return find_sorted(object,stringHash);
    sJSON *c=object->child;
    while(c && compareNames( c, stringHash) )
       c=c->next;
    return c;
 }
+void sJSONinitKeyCache(sJSONKeyCache *cache, eastl::FixedMurmurHash key) {
+   cache->key = key;
+   cache->index = 0;
+}
+sJSON *sJSONgetObjectItemCached(sJSON *object, sJSONKeyCache *cache) {
+   uint32_t i=0, n=cache->index;
+   sJSON *c;
+   if (!materialize(object))
+      return 0;
+   if (object->type&sJSON_IsSorted) {
+      c = n<(uint32_t)object->valueInt ? ((sJSON**)object->valueString)[n] : 0;
+   } else {
+      c=object->child;
+      while (c && i<n) {      /* no name compares on the way to the cached position */
+         i++;
+         c=c->next;
+      }
+   }
+   if (c && !compareNames(c, cache->key))
+      return c;
+   c=object->child;
+   i=0;
+   while(c && compareNames( c, cache->key) ) {
+      i++;
+      c=c->next;
+   }
+   if (c)
+      cache->index = i;
+   return c;
+}
+int sJSONsortObject(sJSON *object) {
+   sJSON *c;
+   if ((object->type&(sJSON_IsPacked|sJSON_IsFrozen))==sJSON_IsPacked)
+      return 1;      /* only numbers, nothing to sort */
+   if (!writable(object))
+      return 0;
+   if ((object->type&255)==sJSON_Object && !sort_children(object))
+      return 0;
+   for (c=object->child;c;c=c->next)
+      if (((c->type&255)==sJSON_Object || (c->type&255)==sJSON_Array) && !sJSONsortObject(c))
+         return 0;
+   return 1;
+}
+#ifdef EASTL_MURMUR_HASH_64
+sJSON *sJSONgetObjectItem(sJSON *object, eastl::murmur_hash_t stringHash) {
+   return sJSONgetObjectItem(object,eastl::FixedMurmurHash(stringHash,0));
+}
+void sJSONstripKeys(sJSON *item) {
+   sJSON *c;
+   if ((item->type&sJSON_IsPacked) || !writable(item))
+      return;
+   for (c=item->child;c;c=c->next) {
+      if (c->nameString && !(c->type&sJSON_IsInterned))
+         sJSON_free(c->nameString);
+      c->nameString=0;
+      c->type&=~sJSON_IsInterned;
+      if (!(c->type&sJSON_IsReference))
+         sJSONstripKeys(c);
+   }
+}
+#endif
+sJSON *sJSONgetChild(sJSON *item) {
+   if (!materialize(item))
+      return 0;
+   return item->child;
+}
 
 
 /* Utility for array list handling. */
@@ -717,39 +2912,79 @@ static void suffix_object(sJSON *prev, sJSON *item) {
 }
 /* Utility for handling references. */
 static sJSON *create_reference(sJSON *item) {
-   sJSON *ref=sJSON_New_Item();
-   if (!ref)
+   sJSON *ref;
+   if (!materialize(item) || !(ref=sJSON_New_Item()))
       return 0;
    memcpy(ref,item,sizeof(sJSON));
    ref->nameString = 0;
    ref->nameHash = 0;
-   ref->type |= sJSON_IsReference;
+   ref->type = (ref->type&~(sJSON_IsInterned|sJSON_IsFrozen|sJSON_IsFrozenRoot|sJSON_IsSorted|sJSON_IsPacked|sJSON_PackedMask)) | sJSON_IsReference;
+   if (item->type&(sJSON_IsSorted|sJSON_IsPacked))
+      ref->valueString=0;     /* the index or frozen buffer stays with item, the reference reads its children in order */
    ref->next = ref->prev = 0;
    return ref;
 }
 
 /* Add item to array/object. */
+/* Link item in after last, the last child of array or NULL when it has none. */
+static void append_item(sJSON *array, sJSON *last, sJSON *item) {
+   drop_index(array);
+   if (!last)
+      array->child=item;
+   else
+      suffix_object(last,item);
+   if (journal)
+      journal_added(array,item);
+}
 void   sJSONaddItemToArray(sJSON *array, sJSON *item) {
-   sJSON *c=array->child;
-   if (!item)
+   if (!item || (item->type&sJSON_IsFrozen))
+      return;
+   if (!writable(array)) {
+      sJSONdelete(item);
       return;
-   if (!c) {
-      array->child=item;
-   } else {
-      while (c && c->next)
-         c=c->next;
-      suffix_object(c,item);
    }
+   sJSON *c=array->child;
+   while (c && c->next)
+      c=c->next;
+   append_item(array,c,item);
 }
 void   sJSONaddItemToObject(sJSON *object, const char *string, sJSON *item)	{
-   if (!item)
+   if (!item || (item->type&sJSON_IsFrozen))
       return;
-   if (item->nameString)
-      sJSON_free(item->nameString);
-   item->nameString=sJSON_strdup(string);
-   item->nameHash = eastl::murmurString(string);
+   if (!writable(object)) {
+      sJSONdelete(item);
+      return;
+   }
+   set_name(item,string,eastl::murmurKeyString(string));
    sJSONaddItemToArray(object,item);
 }
+
+void sJSONbuilderInit(sJSONBuilder *builder, sJSON *container) {
+   builder->container = container && writable(container) ? container : 0;
+   builder->last = builder->container ? builder->container->child : 0;
+   while (builder->last && builder->last->next)
+      builder->last=builder->last->next;
+}
+void sJSONbuilderAdd(sJSONBuilder *builder, sJSON *item) {
+   if (!item || (item->type&sJSON_IsFrozen))
+      return;
+   if (!builder->container) {
+      sJSONdelete(item);
+      return;
+   }
+   append_item(builder->container,builder->last,item);
+   builder->last=item;
+}
+void sJSONbuilderAddToObject(sJSONBuilder *builder, const char *string, sJSON *item) {
+   if (!item || (item->type&sJSON_IsFrozen))
+      return;
+   if (!builder->container) {
+      sJSONdelete(item);
+      return;
+   }
+   set_name(item,string,eastl::murmurKeyString(string));
+   sJSONbuilderAdd(builder,item);
+}
 void	sJSONaddItemReferenceToArray(sJSON *array, sJSON *item) {
    sJSONaddItemToArray(array,create_reference(item));
 }
@@ -758,6 +2993,9 @@ void	sJSONaddItemReferenceToObject(sJSON *object,const char *string,sJSON *item)
 }
 
 sJSON *sJSONdetachItemFromArray(sJSON *array, int which)			{
+   if (!writable(array))
+      return 0;
+   drop_index(array);
    sJSON *c=array->child;
    while (c && which>0) {
       c=c->next;
@@ -765,6 +3003,8 @@ sJSON *sJSONdetachItemFromArray(sJSON *array, int which)			{
    }
    if (!c)
       return 0;
+   if (journal)
+      journal_removed(array,c);
    if (c->prev)
       c->prev->next=c->next;
    if (c->next)
@@ -779,6 +3019,8 @@ void   sJSONdeleteItemFromArray(sJSON *array,int which) {
 }
 sJSON *sJSONdetachItemFromObject(sJSON *object,const char *string) {
    int i=0;
+   if (!materialize(object))
+      return 0;
    sJSON *c=object->child;
    eastl::FixedMurmurHash stringHash(string);
    while(c && compareNames( c, stringHash ) ) {
@@ -796,13 +3038,24 @@ void   sJSONdeleteItemFromObject(sJSON *object,const char *string) {
 
 /* Replace array/object items with new ones. */
 void   sJSONreplaceItemInArray(sJSON *array,int which,sJSON *newitem) {
+   if (!newitem || (newitem->type&sJSON_IsFrozen))
+      return;
+   if (!writable(array)) {
+      sJSONdelete(newitem);
+      return;
+   }
    sJSON *c=array->child;
    while (c && which>0) {
       c=c->next;
       which--;
    }
-   if (!c)
+   if (!c) {
+      sJSONdelete(newitem);
       return;
+   }
+   drop_index(array);
+   if (journal)
+      journal_replaced(array,c,newitem);
    newitem->next=c->next;
    newitem->prev=c->prev;
    if (newitem->next)
@@ -816,17 +3069,24 @@ void   sJSONreplaceItemInArray(sJSON *array,int which,sJSON *newitem) {
 }
 void   sJSONreplaceItemInObject(sJSON *object,const char *string,sJSON *newitem) {
    int i=0;
+   if (!newitem || (newitem->type&sJSON_IsFrozen))
+      return;
+   if (!writable(object)) {
+      sJSONdelete(newitem);
+      return;
+   }
    sJSON *c=object->child;
    eastl::FixedMurmurHash stringHash(string);
    while(c && compareNames( c, stringHash ) ) {
       i++;
       c=c->next;
    }
-   if(c) {
-      newitem->nameString=sJSON_strdup(string);
-      newitem->nameHash = stringHash.mHash;
-      sJSONreplaceItemInArray(object,i,newitem);
+   if (!c) {
+      sJSONdelete(newitem);
+      return;
    }
+   set_name(newitem,string,stringHash.mHash);
+   sJSONreplaceItemInArray(object,i,newitem);
 }
 
 /* Create basic types: */
@@ -835,7 +3095,7 @@ sJSON *sJSONcreateTrue()					{sJSON *item=sJSON_New_Item();if(item)item->type=sJ
 sJSON *sJSONcreateFalse()					{sJSON *item=sJSON_New_Item();if(item)item->type=sJSON_False;return item;}
 sJSON *sJSONcreateBool(int b)				{sJSON *item=sJSON_New_Item();if(item)item->type=b?sJSON_True:sJSON_False;return item;}
 sJSON *sJSONcreateNumber(double num)	{sJSON *item=sJSON_New_Item();if(item){item->type=sJSON_Number;item->valueDouble=num;item->valueInt=(int)num;}return item;}
-sJSON *sJSONcreateString(const char *string)	{sJSON *item=sJSON_New_Item();if(item){item->type=sJSON_String;item->valueString=sJSON_strdup(string);}return item;}
+sJSON *sJSONcreateString(const char *string)	{sJSON *item=sJSON_New_Item();if(item){item->type=sJSON_String;item->valueString=copy_value(string);}return item;}
 sJSON *sJSONcreateArray()					{sJSON *item=sJSON_New_Item();if(item)item->type=sJSON_Array;return item;}
 sJSON *sJSONcreateObject()					{sJSON *item=sJSON_New_Item();if(item)item->type=sJSON_Object;return item;}
 
@@ -843,4 +3103,720 @@ sJSON *sJSONcreateObject()					{sJSON *item=sJSON_New_Item();if(item)item->type=
 sJSON *sJSONcreateIntArray(int *numbers,int count)				 {int i;sJSON *n=0,*p=0,*a=sJSONcreateArray();for(i=0;a && i<count;i++){n=sJSONcreateNumber(numbers[i]);if(!i)a->child=n;else suffix_object(p,n);p=n;}return a;}
 sJSON *sJSONcreateFloatArray(float *numbers,int count)		 {int i;sJSON *n=0,*p=0,*a=sJSONcreateArray();for(i=0;a && i<count;i++){n=sJSONcreateNumber(numbers[i]);if(!i)a->child=n;else suffix_object(p,n);p=n;}return a;}
 sJSON *sJSONcreateDoubleArray(double *numbers,int count)		 {int i;sJSON *n=0,*p=0,*a=sJSONcreateArray();for(i=0;a && i<count;i++){n=sJSONcreateNumber(numbers[i]);if(!i)a->child=n;else suffix_object(p,n);p=n;}return a;}
+sJSON *sJSONcreatePackedArray(const void *numbers,int count,int kind) {
+   size_t size=count*(size_t)((kind&sJSON_PackedMask)==sJSON_PackedInt64 || (kind&sJSON_PackedMask)==sJSON_PackedDouble ? 8 : 4);
+   sJSON *a=sJSONcreateArray();
+   char *copy;
+   if (!a || count<=0)
+      return a;
+   if (!(copy=(char*)sJSON_malloc(size))) {
+      sJSONdelete(a);
+      return 0;
+   }
+   memcpy(copy,numbers,size);
+   a->type|=sJSON_IsPacked|(kind&sJSON_PackedMask);
+   a->valueString=copy;
+   a->valueInt=count;
+   return a;
+}
 sJSON *sJSONcreateStringArray(const char **strings,int count){int i;sJSON *n=0,*p=0,*a=sJSONcreateArray();for(i=0;a && i<count;i++){n=sJSONcreateString(strings[i]);if(!i)a->child=n;else suffix_object(p,n);p=n;}return a;}
+
+/* Value setters. */
+static void clear_value(sJSON *item) {
+   sJSON *c;
+   if (!(item->type&sJSON_IsReference)) {
+      if (journal)
+         for (c=item->child;c;c=c->next)
+            journal_untrack(journal,c);
+      sJSONdelete(item->child);
+      if (item->valueString && !(item->type&sJSON_IsLazy))
+         sJSON_free(item->valueString);
+   }
+   item->child=0;
+   item->valueString=0;
+   item->valueInt=0;
+   item->valueDouble=0;
+   item->type&=sJSON_IsInterned;
+}
+static void journal_changed(sJSON *item) {
+   sJSON *parent=journal_parent(journal,item);
+   if (parent)
+      journal_record(journal,JOURNAL_REPLACE,parent,item,item);
+}
+void sJSONsetNumber(sJSON *item, double num) {
+   if (item->type&sJSON_IsFrozen)
+      return;
+   clear_value(item);
+   item->type|=sJSON_Number;
+   item->valueDouble=num;
+   item->valueInt=(int)num;
+   if (journal)
+      journal_changed(item);
+}
+void sJSONsetString(sJSON *item, const char *string) {
+   char *copy;
+   if ((item->type&sJSON_IsFrozen) || !(copy=copy_value(string)))
+      return;
+   clear_value(item);
+   item->type|=sJSON_String;
+   item->valueString=copy;
+   if (journal)
+      journal_changed(item);
+}
+void sJSONsetBool(sJSON *item, int b) {
+   if (item->type&sJSON_IsFrozen)
+      return;
+   clear_value(item);
+   item->type|=b?sJSON_True:sJSON_False;
+   item->valueInt=b?1:0;
+   if (journal)
+      journal_changed(item);
+}
+
+/* Change journal. */
+sJSONJournal *sJSONcreateJournal(sJSON *root) {
+   sJSONJournal *j=(sJSONJournal*)sJSON_malloc(sizeof(sJSONJournal));
+   sJSON *c;
+   if (!j)
+      return 0;
+   memset(j,0,sizeof(sJSONJournal));
+   j->root=root;
+   j->capacity=64;
+   if (!(j->parents=(sJSONParentEntry*)sJSON_malloc(j->capacity*sizeof(sJSONParentEntry)))) {
+      sJSON_free(j);
+      return 0;
+   }
+   memset(j->parents,0,j->capacity*sizeof(sJSONParentEntry));
+   for (c=root->child;c;c=c->next)
+      journal_track(j,c,root);
+   if (j->failed) {
+      sJSONdeleteJournal(j);
+      return 0;
+   }
+   return j;
+}
+void sJSONdeleteJournal(sJSONJournal *j) {
+   if (!j)
+      return;
+   if (journal==j)
+      journal=0;
+   if (j->ops.data)
+      sJSON_free(j->ops.data);
+   sJSON_free(j->parents);
+   sJSON_free(j);
+}
+void sJSONsetJournal(sJSONJournal *j) {
+   journal=j;
+}
+
+char *sJSONjournalPrintPatch(sJSONJournal *j) {
+   sJSONBuffer out={0,0,0};
+   uint32_t pos=0, len;
+   char *path, *str;
+   int ok=!j->failed && buffer_append(&out,"[",1);
+   while (ok && pos<j->ops.size) {
+      const char *op=journal_ops[(int)j->ops.data[pos]];
+      len=read_u32(j->ops.data+pos+1);
+      if (!(path=(char*)sJSON_malloc(len+1)))
+         break;
+      memcpy(path,j->ops.data+pos+5,len);
+      path[len]=0;
+      str=print_string_ptr(path);
+      sJSON_free(path);
+      pos+=5+len;
+      len=read_u32(j->ops.data+pos);
+      ok = str && (out.size==1 || buffer_append(&out,",",1)) && buffer_append_string(&out,"{\"op\":\"")
+         && buffer_append_string(&out,op) && buffer_append_string(&out,"\",\"path\":") && buffer_append_string(&out,str)
+         && (!len || (buffer_append_string(&out,",\"value\":") && buffer_append(&out,j->ops.data+pos+4,len)))
+         && buffer_append(&out,"}",1);
+      if (str)
+         sJSON_free(str);
+      pos+=4+len;
+   }
+   if (!ok || pos<j->ops.size || !buffer_append(&out,"]",2)) {
+      if (out.data)
+         sJSON_free(out.data);
+      return 0;
+   }
+   j->ops.size=0;
+   return out.data;
+}
+
+char *sJSONjournalPrintBinary(sJSONJournal *j, uint32_t *size) {
+   sJSONBuffer out={0,0,0};
+   if (j->failed || !buffer_append(&out,journal_magic,4) || (j->ops.size && !buffer_append(&out,j->ops.data,j->ops.size))) {
+      if (out.data)
+         sJSON_free(out.data);
+      return 0;
+   }
+   *size=out.size;
+   j->ops.size=0;
+   return out.data;
+}
+
+/* Deep copy of an item, for values taken from a patch. */
+static sJSON *duplicate(sJSON *item) {
+   sJSON *copy, *c, *n, *prev=0;
+   if (!materialize(item) || !(copy=sJSON_New_Item()))
+      return 0;
+   copy->type=item->type&(255|sJSON_IsReordered);    /* the children are copied in their current order */
+   copy->valueInt=item->valueInt;
+   copy->valueDouble=item->valueDouble;
+   if (copy->type==sJSON_String && item->valueString && !(copy->valueString=copy_value(item->valueString))) {
+      sJSONdelete(copy);
+      return 0;
+   }
+   for (c=item->child;c;c=c->next) {
+      if (!(n=duplicate(c)) || (c->nameString && !set_name(n,c->nameString,c->nameHash))) {
+         sJSONdelete(n);
+         sJSONdelete(copy);
+         return 0;
+      }
+      n->nameHash=c->nameHash;
+      if (prev)
+         suffix_object(prev,n);
+      else
+         copy->child=n;
+      prev=n;
+   }
+   return copy;
+}
+
+/* Parse a single value, which sJSONparse would take for an object without braces. */
+static sJSON *parse_value_text(const char *text) {
+   sJSON *c=sJSON_New_Item();
+   if (c && !parse_value(c,skip(text))) {
+      sJSONdelete(c);
+      return 0;
+   }
+   return c;
+}
+
+/* Insert item before position which, or append it if which is the array size. */
+static int insert_item(sJSON *array, int which, sJSON *item) {
+   sJSON *c;
+   if (!writable(array))
+      return 0;
+   c=array->child;
+   while (c && which>0) {
+      c=c->next;
+      which--;
+   }
+   if (which)
+      return 0;
+   if (!c) {
+      sJSONaddItemToArray(array,item);
+      return 1;
+   }
+   item->next=c;
+   item->prev=c->prev;
+   if (c->prev)
+      c->prev->next=item;
+   else
+      array->child=item;
+   c->prev=item;
+   if (journal)
+      journal_added(array,item);
+   return 1;
+}
+
+/* Apply one operation to the item a JSON Pointer refers to. value is consumed. */
+static int apply_operation(sJSON *root, int op, const char *path, sJSON *value) {
+   char *token=(char*)sJSON_malloc(strlen(path)+1), *out;
+   sJSON *parent=root, *c;
+   int ok=0, index=-1;
+   if (!token || *path!='/') {
+      sJSON_free(token);
+      sJSONdelete(value);
+      return 0;
+   }
+   for (;;) {
+      for (out=token,path++;*path && *path!='/';path++)    /* unescape ~0 and ~1 */
+         *out++ = (*path=='~' && (path[1]=='0' || path[1]=='1')) ? (*++path=='0' ? '~' : '/') : *path;
+      *out=0;
+      if ((parent->type&255)==sJSON_Array) {
+         for (index=0,out=token;*out>='0' && *out<='9';out++)
+            index=index*10+(*out-'0');
+         if (*out || out==token)
+            index=-1;
+      }
+      if (!*path)
+         break;
+      eastl::FixedMurmurHash hash(token);
+      parent = (parent->type&255)==sJSON_Object ? sJSONgetObjectItem(parent,hash)
+             : index>=0 ? sJSONgetArrayItem(parent,index) : 0;
+      if (!parent)
+         break;
+   }
+
+   if (parent && !*path && writable(parent)) {
+      if ((parent->type&255)==sJSON_Object) {
+         eastl::FixedMurmurHash hash(token);
+         c=sJSONgetObjectItem(parent,hash);
+         if (op==JOURNAL_REMOVE)
+            sJSONdelete(sJSONdetachItemFromObject(parent,token));
+         else if (c)
+            sJSONreplaceItemInObject(parent,token,value);    /* add replaces an existing member */
+         else if (op==JOURNAL_ADD)
+            sJSONaddItemToObject(parent,token,value);
+         ok = c || op==JOURNAL_ADD;
+      } else if ((parent->type&255)==sJSON_Array) {
+         if (op==JOURNAL_ADD && !strcmp(token,"-")) {
+            sJSONaddItemToArray(parent,value);
+            ok=1;
+         } else if (index>=0 && op==JOURNAL_ADD) {
+            ok=insert_item(parent,index,value);
+         } else if (index>=0 && (c=sJSONgetArrayItem(parent,index))) {
+            if (op==JOURNAL_REMOVE)
+               sJSONdeleteItemFromArray(parent,index);
+            else
+               sJSONreplaceItemInArray(parent,index,value);
+            ok=1;
+         }
+      }
+   }
+   if (!ok || op==JOURNAL_REMOVE)
+      sJSONdelete(value);
+   sJSON_free(token);
+   return ok;
+}
+
+int sJSONapplyPatch(sJSON *root, sJSON *patch) {
+   sJSON *op, *path, *value;
+   int code;
+   for (op=sJSONgetChild(patch);op;op=op->next) {
+      path=sJSONgetObjectItem(op,"path");
+      value=sJSONgetObjectItem(op,"op");
+      if (!path || !value || (path->type&255)!=sJSON_String || (value->type&255)!=sJSON_String)
+         return 0;
+      for (code=0;code<3 && strcmp(value->valueString,journal_ops[code]);code++)
+         ;
+      if (code==3)
+         return 0;      /* move, copy and test are not supported */
+      value=0;
+      if (code!=JOURNAL_REMOVE) {
+         value=sJSONgetObjectItem(op,"value");
+         if (!value || !(value=duplicate(value)))
+            return 0;
+      }
+      if (!apply_operation(root,code,path->valueString,value))
+         return 0;
+   }
+   return 1;
+}
+
+int sJSONapplyBinaryPatch(sJSON *root, const char *data, uint32_t size) {
+   uint32_t pos=4, pathLen, valueLen;
+   char *text;
+   sJSON *value;
+   int ok;
+   if (size<4 || memcmp(data,journal_magic,4))
+      return 0;
+   while (pos<size) {
+      if (size-pos<9 || (unsigned char)data[pos]>JOURNAL_REPLACE)
+         return 0;
+      pathLen=read_u32(data+pos+1);
+      if (size-pos-9<pathLen)
+         return 0;
+      valueLen=read_u32(data+pos+5+pathLen);
+      if (size-pos-9-pathLen<valueLen || !(text=(char*)sJSON_malloc(pathLen+valueLen+2)))
+         return 0;
+      memcpy(text,data+pos+5,pathLen);
+      text[pathLen]=0;
+      memcpy(text+pathLen+1,data+pos+9+pathLen,valueLen);
+      text[pathLen+1+valueLen]=0;
+      value=0;
+      ok = data[pos]==JOURNAL_REMOVE || (value=parse_value_text(text+pathLen+1));
+      ok = ok && apply_operation(root,data[pos],text,value);
+      sJSON_free(text);
+      if (!ok)
+         return 0;
+      pos+=9+pathLen+valueLen;
+   }
+   return 1;
+}
+
+/* Frozen trees: one block holding a header, the nodes, the sorted indexes, the packed arrays and the strings.
+   Each container's children are consecutive nodes. */
+typedef struct sJSONFrozen {
+   std::atomic<int> refs;     /* the handle and readers holding the tree */
+   size_t size;               /* of the whole block */
+} sJSONFrozen;
+
+static const size_t frozen_header = (sizeof(sJSONFrozen)+15)&~(size_t)15;
+
+static sJSONFrozen *frozen_block(sJSON *root) {
+   return (sJSONFrozen*)((char*)root-frozen_header);
+}
+static void free_frozen(sJSON *root) {
+   sJSONFrozen *block=frozen_block(root);
+   block->~sJSONFrozen();
+   sJSON_free(block);
+}
+
+typedef struct sJSONFreezer {
+   sJSON *nodes;
+   sJSON **indexes;
+   char *packed;
+   char *strings;
+} sJSONFreezer;
+
+/* Packed buffers are kept 8 byte aligned for their int64s and doubles. */
+static size_t frozen_align(size_t size) {
+   return (size+7)&~(size_t)7;
+}
+
+/* Count the children, index entries, packed and string bytes a frozen copy of item needs. */
+static int freeze_count(sJSON *item, size_t *nodes, size_t *indexes, size_t *packed, size_t *strings) {
+   sJSON *c;
+   if (item->nameString && !(item->type&sJSON_IsInterned))
+      *strings+=strlen(item->nameString)+1;
+   if (item->type&sJSON_IsPacked) {    /* the buffer copied as it is, and a read only item per number */
+      *packed+=frozen_align(packed_size(item));
+      *nodes+=item->valueInt;
+      return 1;
+   }
+   if (!materialize(item))
+      return 0;
+   if ((item->type&255)==sJSON_String && item->valueString)
+      *strings+=strlen(item->valueString)+1;
+   if (item->type&sJSON_IsSorted)
+      *indexes+=item->valueInt;
+   for (c=item->child;c;c=c->next) {
+      (*nodes)++;
+      if (!freeze_count(c,nodes,indexes,packed,strings))
+         return 0;
+   }
+   return 1;
+}
+
+static char *freeze_string(sJSONFreezer *f, const char *str) {
+   size_t len=strlen(str)+1;
+   char *copy=f->strings;
+   memcpy(copy,str,len);
+   f->strings+=len;
+   return copy;
+}
+
+static void freeze_item(sJSONFreezer *f, sJSON *dst, const sJSON *src) {
+   sJSON *c, *children=f->nodes;
+   uint32_t n=0, i;
+   dst->type=(src->type&~(sJSON_IsReference|sJSON_IsLazy|sJSON_IsFrozenRoot))|sJSON_IsFrozen;
+   dst->valueInt=src->valueInt;
+   dst->valueDouble=src->valueDouble;
+   dst->nameHash=src->nameHash;
+   dst->nameString = !src->nameString || (src->type&sJSON_IsInterned) ? src->nameString : freeze_string(f,src->nameString);
+   dst->valueString = (src->type&255)==sJSON_String && src->valueString ? freeze_string(f,src->valueString) : 0;
+   if (src->type&sJSON_IsPacked) {
+      dst->valueString=(char*)memcpy(f->packed,src->valueString,packed_size(src));
+      f->packed+=frozen_align(packed_size(src));
+      n=src->valueInt;
+      f->nodes+=n;
+      dst->child=children;
+      for (i=0;i<n;i++) {
+         children[i].prev = i ? &children[i-1] : 0;
+         children[i].next = i+1<n ? &children[i+1] : 0;
+         children[i].type=sJSON_Number|sJSON_IsFrozen;
+         children[i].valueDouble=packed_value(src,i);
+         children[i].valueInt=packed_int(children[i].valueDouble);
+      }
+      return;
+   }
+   for (c=src->child;c;c=c->next)
+      n++;
+   f->nodes+=n;
+   dst->child = n ? children : 0;
+   for (c=src->child,i=0;c;c=c->next,i++) {
+      children[i].prev = i ? &children[i-1] : 0;
+      children[i].next = i+1<n ? &children[i+1] : 0;
+      children[i].child = 0;
+      freeze_item(f,&children[i],c);
+   }
+   if (src->type&sJSON_IsSorted) {   /* the children are already in index order */
+      dst->valueString=(char*)f->indexes;
+      for (i=0;i<n;i++)
+         *f->indexes++=&children[i];
+   }
+}
+
+static sJSON *freeze(sJSON *item, size_t *nodesOut, size_t *indexesOut) {
+   size_t nodes=1, indexes=0, packed=0, strings=0, tables, size;
+   sJSONFreezer f;
+   sJSONFrozen *block;
+   sJSON *root;
+   if (!item || !freeze_count(item,&nodes,&indexes,&packed,&strings))
+      return 0;
+   *nodesOut=nodes;
+   *indexesOut=indexes;
+   tables=frozen_align(nodes*sizeof(sJSON)+indexes*sizeof(sJSON*))+packed;
+   size=frozen_header+tables+strings;
+   if (!(block=(sJSONFrozen*)sJSON_malloc(size)))
+      return 0;
+   stats.nodes+=nodes;
+   new (block) sJSONFrozen();
+   block->refs=1;
+   block->size=size;
+   root=(sJSON*)((char*)block+frozen_header);
+   memset(root,0,tables);    /* padding too, cached images are written as they are */
+   f.nodes=root+1;
+   f.indexes=(sJSON**)(root+nodes);
+   f.packed=(char*)root+frozen_align(nodes*sizeof(sJSON)+indexes*sizeof(sJSON*));
+   f.strings=(char*)root+tables;
+   root->next=root->prev=root->child=0;
+   freeze_item(&f,root,item);
+   root->type|=sJSON_IsFrozenRoot;
+   return root;
+}
+sJSON *sJSONfreeze(sJSON *item) {
+   size_t nodes, indexes;
+   return freeze(item,&nodes,&indexes);
+}
+
+/* Hot swap handle. Readers count themselves in acquiring[epoch&1] while they load current and take a reference,
+   so a swap only waits for readers that might have seen the old root, never the other way around. */
+struct sJSONHandle {
+   std::atomic<sJSON*> current;
+   std::atomic<uint32_t> epoch;
+   std::atomic<int> acquiring[2];
+   std::mutex writer;
+};
+
+sJSONHandle *sJSONcreateHandle(sJSON *frozen) {
+   sJSONHandle *handle;
+   if (!frozen || !(frozen->type&sJSON_IsFrozenRoot) || !(handle=(sJSONHandle*)sJSON_malloc(sizeof(sJSONHandle))))
+      return 0;
+   new (handle) sJSONHandle();
+   handle->current=frozen;
+   handle->epoch=0;
+   handle->acquiring[0]=handle->acquiring[1]=0;
+   return handle;
+}
+
+void sJSONdeleteHandle(sJSONHandle *handle) {
+   if (!handle)
+      return;
+   sJSONrelease(handle->current.load());
+   handle->~sJSONHandle();
+   sJSON_free(handle);
+}
+
+sJSON *sJSONacquire(sJSONHandle *handle) {
+   uint32_t epoch;
+   for (;;) {
+      epoch=handle->epoch.load();
+      handle->acquiring[epoch&1]++;
+      if (handle->epoch.load()==epoch)
+         break;
+      handle->acquiring[epoch&1]--;    /* a swap started, count in with the new epoch */
+   }
+   sJSON *root=handle->current.load();
+   frozen_block(root)->refs++;
+   handle->acquiring[epoch&1]--;
+   return root;
+}
+
+void sJSONrelease(sJSON *frozen) {
+   if (frozen && --frozen_block(frozen)->refs==0)
+      free_frozen(frozen);
+}
+
+int sJSONswap(sJSONHandle *handle, sJSON *frozen) {
+   if (!frozen || !(frozen->type&sJSON_IsFrozenRoot))
+      return 0;
+   std::lock_guard<std::mutex> guard(handle->writer);
+   sJSON *old=handle->current.exchange(frozen);
+   uint32_t epoch=handle->epoch++;
+   while (handle->acquiring[epoch&1].load())
+      std::this_thread::yield();
+   sJSONrelease(old);
+   return 1;
+}
+
+/* Parse cache. An image is a frozen block with its pointers turned into offsets from the block, after a
+   header that says which text and which build it belongs to. It is named by the hash of the text. */
+typedef struct sJSONCacheHeader {
+   char magic[4];
+   uint32_t version;
+   uint32_t config;        /* sizeof(sJSON), pointer size and parse options */
+   uint32_t reserved;
+   uint64_t keyHash;       /* of a fixed key, so images from another hash policy are not used */
+   uint64_t text[2];       /* murmurHash_x64_128 of the text */
+   uint64_t length;        /* of the text */
+   uint64_t nodes, indexes, size;  /* of the frozen block */
+   uint64_t checksum[2];   /* murmurHash_x64_128 of the image */
+} sJSONCacheHeader;
+
+static const char cache_magic[4] = {'s','J','C','1'};
+static const uint32_t cache_version = 4;    /* 2: the root carries sJSON_IsFrozenRoot, 3: packed arrays stay packed,
+                                               4: with an item per number */
+
+static void cache_header(sJSONCacheHeader *header, const uint64_t *text, size_t length) {
+   memset(header,0,sizeof(sJSONCacheHeader));
+   memcpy(header->magic,cache_magic,sizeof(cache_magic));
+   header->version=cache_version;
+   header->config=(uint32_t)(sizeof(sJSON)<<16 | sizeof(void*)<<8 | parse_options);
+   header->keyHash=eastl::murmurKeyHash((const uint8_t*)"sJSON",5);
+   header->text[0]=text[0];
+   header->text[1]=text[1];
+   header->length=length;
+}
+
+/* Move a pointer in a frozen block from one base to another, 0 if it doesn't point into the block. */
+template<typename T>
+static int relocate(T **slot, uintptr_t from, uintptr_t to, size_t size) {
+   uintptr_t offset=(uintptr_t)*slot-from;
+   if (!*slot)
+      return 1;
+   if (offset<frozen_header || offset>=size)
+      return 0;
+   *slot=(T*)(to+offset);
+   return 1;
+}
+static int relocate_frozen(sJSON *root, size_t nodes, size_t indexes, size_t size, uintptr_t from, uintptr_t to) {
+   sJSON **index=(sJSON**)(root+nodes);
+   size_t i;
+   for (i=0;i<nodes;i++)
+      if (!relocate(&root[i].next,from,to,size) || !relocate(&root[i].prev,from,to,size) || !relocate(&root[i].child,from,to,size)
+          || !relocate(&root[i].nameString,from,to,size) || !relocate(&root[i].valueString,from,to,size))
+         return 0;
+   for (i=0;i<indexes;i++)
+      if (!relocate(&index[i],from,to,size))
+         return 0;
+   return 1;
+}
+
+/* Name the image for text. Returns 0 if the name doesn't fit in size, and the text isn't cached. */
+static int cache_path(char *path, size_t size, const char *dir, const uint64_t *text) {
+   int len=snprintf(path,size,"%s/%016llx%016llx.sjc",dir,(unsigned long long)text[0],(unsigned long long)text[1]);
+   return len>0 && (size_t)len<size;
+}
+
+/* Load the image for text, or return 0 if there is none that matches. */
+static sJSON *load_cached(const char *path, const sJSONCacheHeader *expect) {
+   sJSONCacheHeader header;
+   sJSONFrozen *block=0;
+   sJSON *root;
+   uint64_t checksum[2];
+   FILE *f=fopen(path,"rb");
+   if (!f)
+      return 0;
+   if (fread(&header,sizeof(header),1,f)!=1 || memcmp(&header,expect,offsetof(sJSONCacheHeader,nodes))
+       || header.size<=frozen_header || header.size>UINT32_MAX || header.nodes<1 || header.nodes>header.size || header.indexes>header.size
+       || (header.nodes*sizeof(sJSON)+header.indexes*sizeof(sJSON*)) > header.size-frozen_header
+       || !(block=(sJSONFrozen*)sJSON_malloc(header.size))) {
+      fclose(f);
+      return 0;
+   }
+   root=(sJSON*)((char*)block+frozen_header);
+   if (fread(root,header.size-frozen_header,1,f)!=1) {
+      fclose(f);
+      sJSON_free(block);
+      return 0;
+   }
+   fclose(f);
+   eastl::murmurHash_x64_128((const uint8_t*)root,(uint32_t)(header.size-frozen_header),checksum);
+   if (checksum[0]!=header.checksum[0] || checksum[1]!=header.checksum[1]
+       || !relocate_frozen(root,header.nodes,header.indexes,header.size,0,(uintptr_t)block)) {
+      sJSON_free(block);
+      return 0;
+   }
+   stats.nodes+=header.nodes;
+   new (block) sJSONFrozen();
+   block->refs=1;
+   block->size=header.size;
+   return root;
+}
+
+/* Write the image of a frozen root, through a temporary file so readers never see half of one. */
+static void store_cached(const char *path, sJSONCacheHeader *header, sJSON *root, size_t nodes, size_t indexes) {
+   sJSONFrozen *block=frozen_block(root);
+   size_t size=block->size;
+   char tmp[1100];
+   int ok, len;
+   long pid=0;
+   FILE *f;
+#if defined(sJSON_MMAP)
+   pid=(long)getpid();
+#elif defined(_WIN32)
+   pid=(long)_getpid();
+#endif
+   len=snprintf(tmp,sizeof(tmp),"%s.%ld.%llx.tmp",path,pid,(unsigned long long)(uintptr_t)&ep);   /* unique per process and thread */
+   if (len<=0 || (size_t)len>=sizeof(tmp) || !(f=fopen(tmp,"wb")))
+      return;
+   header->nodes=nodes;
+   header->indexes=indexes;
+   header->size=size;
+   relocate_frozen(root,nodes,indexes,size,(uintptr_t)block,0);
+   eastl::murmurHash_x64_128((const uint8_t*)root,(uint32_t)(size-frozen_header),header->checksum);
+   ok = fwrite(header,sizeof(sJSONCacheHeader),1,f)==1 && fwrite(root,size-frozen_header,1,f)==1;
+   relocate_frozen(root,nodes,indexes,size,0,(uintptr_t)block);
+   ok = fclose(f)==0 && ok;
+#ifdef _WIN32
+   if (ok)
+      remove(path);     /* rename doesn't replace an existing file here */
+#endif
+   if (!ok || rename(tmp,path)!=0)
+      remove(tmp);
+}
+
+sJSON *sJSONparseCached(const char *value, size_t length, const char *cacheDir) {
+   sJSONCacheHeader header;
+   uint64_t text[2];
+   char path[1024];
+   size_t nodes, indexes;
+   sJSON *parsed, *root;
+   int worker=parse_worker, cached = cacheDir && length<=UINT32_MAX;
+   if (cached) {
+      eastl::murmurHash_x64_128((const uint8_t*)value,(uint32_t)length,text);
+      cache_header(&header,text,length);
+      cached=cache_path(path,sizeof(path),cacheDir,text);
+      if (cached && (root=load_cached(path,&header))) {
+         ep=0;
+         return root;
+      }
+   }
+
+   parse_worker=1;      /* names must be in the image, not in the key table */
+   parsed=sJSONparse(value);
+   parse_worker=worker;
+   if (!parsed)
+      return 0;
+   if ((root=freeze(parsed,&nodes,&indexes)) && cached)
+      store_cached(path,&header,root,nodes,indexes);
+   sJSONdelete(parsed);
+   return root;
+}
+
+size_t sJSONmemoryUsage(sJSON *item, sJSONMemory *usage) {
+   sJSONMemory own;
+   sJSON *c;
+   if (!usage)
+      usage=&own;
+   memset(usage,0,sizeof(sJSONMemory));
+   if (!item)
+      return 0;
+   usage->nodes=1;
+   usage->nodeBytes=sizeof(sJSON);
+   if (item->nameString && !(item->type&sJSON_IsInterned))
+      usage->keyBytes=strlen(item->nameString)+1;
+   if (item->type&sJSON_IsSorted)
+      usage->indexBytes=item->valueInt*sizeof(sJSON*);
+   if (item->type&sJSON_IsPacked)
+      usage->packedBytes=packed_size(item);
+   else if ((item->type&255)==sJSON_String && item->valueString && !(item->type&sJSON_IsReference))
+      usage->stringBytes=strlen(item->valueString)+1;
+   if (!(item->type&(sJSON_IsReference|sJSON_IsLazy))) {
+      for (c=item->child;c;c=c->next) {
+         sJSONMemory child;
+         sJSONmemoryUsage(c,&child);
+         usage->nodes+=child.nodes;
+         usage->nodeBytes+=child.nodeBytes;
+         usage->stringBytes+=child.stringBytes;
+         usage->keyBytes+=child.keyBytes;
+         usage->indexBytes+=child.indexBytes;
+         usage->packedBytes+=child.packedBytes;
+      }
+   }
+   usage->total=usage->nodeBytes+usage->stringBytes+usage->keyBytes+usage->indexBytes+usage->packedBytes;
+   return usage->total;
+}
@@ -37,6 +37,29 @@
 #define sJSON_Object 6
 	
 #define sJSON_IsReference 256
+#define sJSON_IsInterned 512     /* nameString is owned by a sJSONKeyTable. Mask type with 255 for the value type. */
+#define sJSON_IsLazy 1024        /* children not parsed yet, valueString points at the container's source text */
+#define sJSON_IsSorted 2048      /* children are in nameHash order, valueString holds an array of them */
+#define sJSON_IsFrozen 4096      /* part of a tree made by sJSONfreeze, read only */
+#define sJSON_IsPacked 8192      /* array of numbers held in a buffer in valueString, valueInt of them */
+#define sJSON_IsFrozenRoot 65536 /* the root of a sJSONfreeze block, the only frozen item sJSONdelete frees */
+#define sJSON_IsReordered 131072 /* children were sorted by hash once, their original key order is gone */
+
+/* Element type of a packed array, mask type with sJSON_PackedMask: */
+#define sJSON_PackedInt32 0
+#define sJSON_PackedInt64 16384
+#define sJSON_PackedFloat 32768
+#define sJSON_PackedDouble 49152
+#define sJSON_PackedMask 49152
+
+/* Parse options: */
+#define sJSON_ParseSortObjects 1 /* sort every parsed object, see sJSONsortObject */
+#define sJSON_ParsePackArrays 2  /* arrays of only numbers become packed, in the narrowest kind that holds them */
+#define sJSON_ParseValidateUTF8 4 /* fail on text that isn't well formed UTF-8 */
+
+/* sJSONparseFile flags: */
+#define sJSON_FileParallel 1     /* parse with sJSONparseParallel */
+#define sJSON_FilePrefault 2     /* fault the file in on another thread while it is parsed */
 
 #include "murmurhash.h"
 
@@ -55,7 +78,7 @@ typedef struct sJSON {
 
    char *nameString;			/* The item's name string, if this item is the child of, or is
                               in the list of subitems of an object. */
-   uint32_t nameHash;
+   eastl::murmur_hash_t nameHash;   /* 64bit when built with EASTL_MURMUR_HASH_64 */
 } sJSON;
 
 typedef struct sJSON_Hooks {
@@ -66,9 +89,121 @@ typedef struct sJSON_Hooks {
 /* Supply malloc, realloc and free functions to sJSON */
 extern void sJSONinitHooks(sJSON_Hooks* hooks);
 
+/* What sJSON has allocated on this thread since sJSONresetStats, including the work sJSONparseMany and
+   sJSONparseParallel hand to other threads. Reset before a parse or print to see what it costs. */
+typedef struct sJSONStats {
+   size_t allocations;     /* calls to the malloc hook */
+   size_t frees;           /* calls to the free hook */
+   size_t bytes;           /* asked of the malloc hook */
+   size_t nodes;           /* sJSON items made */
+   size_t stringBytes;     /* string values copied, with their terminators */
+   size_t keyBytes;        /* keys copied, into items or new key table entries */
+} sJSONStats;
+extern void sJSONgetStats(sJSONStats *stats);
+extern void sJSONresetStats();
+
+/* The memory a tree holds, by kind. Keys in a key table and the source text of lazy containers aren't
+   counted, nor are the items under a reference. Returns total, usage may be NULL. */
+typedef struct sJSONMemory {
+   size_t nodes;
+   size_t nodeBytes;
+   size_t stringBytes;
+   size_t keyBytes;
+   size_t indexBytes;      /* of sorted objects */
+   size_t packedBytes;     /* of packed arrays */
+   size_t total;
+} sJSONMemory;
+
+/* Where parsing and printing spend their time on this thread since sJSONresetProfile, when sjson.cpp is
+   built with sJSON_PROFILE defined. Ticks are rdtsc cycles on x86, steady_clock ticks elsewhere. A phase's
+   ticks leave out the phases it calls, so a string's allocation counts under alloc, and parse and print
+   are what remains of the value and container code. Bytes are of input, or output for the print phases,
+   or asked of the malloc hook for alloc. Work on the threads of sJSONparseMany and sJSONparseParallel is
+   added to the calling thread's profile when they finish, so its ticks can add up to more than the time
+   the call took. */
+#ifdef sJSON_PROFILE
+typedef struct sJSONPhase {
+   uint64_t ticks;
+   uint64_t calls;
+   uint64_t bytes;
+} sJSONPhase;
+typedef struct sJSONProfile {
+   sJSONPhase parse, skip, string, number, key;
+   sJSONPhase print, printString, printNumber;
+   sJSONPhase alloc, free;
+} sJSONProfile;
+extern void sJSONgetProfile(sJSONProfile *profile);
+extern void sJSONresetProfile();
+#endif
+
+/* Intern table for object keys. While a table is set, keys parsed or added to objects are stored once in
+   the table and shared by every item using them. The table can be shared across any number of documents
+   but must outlive all of them. Pass NULL to sJSONsetKeyTable to stop interning. */
+typedef struct sJSONKeyTable sJSONKeyTable;
+extern sJSONKeyTable *sJSONcreateKeyTable();
+extern void sJSONdeleteKeyTable(sJSONKeyTable *table);
+extern void sJSONsetKeyTable(sJSONKeyTable *table);
+/* Intern a key and return its hash. Lookups with the result compare names by pointer. */
+extern eastl::FixedMurmurHash sJSONinternKey(sJSONKeyTable *table, const char *string);
+
+
+/* Set the options used by the parse functions, a combination of the sJSON_Parse flags. */
+extern void sJSONsetParseOptions(int options);
 
 /* Supply a block of JSON, and this returns a sJSON object you can interrogate. Call sJSON_Delete when finished. */
 extern sJSON *sJSONparse(const char *value);
+/* Like sJSONparse, but the children of each array or object are only parsed when it is first reached through
+   the accessors below or sJSONgetChild. Containers that are never reached are skipped over, not built.
+   value must stay valid until the result is deleted, and syntax errors are only reported (as a NULL result
+   and sJSONgetErrorPtr) by the access that reaches them. */
+extern sJSON *sJSONparseLazy(const char *value);
+/* 1 if length bytes of text are well formed UTF-8: no overlong forms, surrogates or code points past
+   0x10FFFF. The sJSON_ParseValidateUTF8 option runs this over the text before parsing it. */
+extern int sJSONvalidateUTF8(const char *text, size_t length);
+
+/* Parse a buffer of many documents, like JSON Lines, on a pool of threads. A document is a {} or [] container,
+   or a braceless sJSON record that ends with its line. callback is called on the calling thread with each
+   document in buffer order and owns it; it gets NULL for a document that failed to parse, and then
+   sJSONgetErrorPtr points at the error in buf. Return 0 from callback to stop. Documents are parsed without
+   the key table, and the malloc/free hooks must be thread safe. Returns the number of documents delivered. */
+typedef int (*sJSONDocumentCallback)(sJSON *document, void *user);
+extern uint32_t sJSONparseMany(const char *buf, size_t len, sJSONDocumentCallback callback, void *user);
+/* Like sJSONparse, but the top level array or object of a big document is cut into ranges that are parsed
+   on several threads and joined, with the same result. Small documents, and any the ranges don't parse
+   cleanly, go to sJSONparse. The malloc/free hooks must be thread safe. */
+extern sJSON *sJSONparseParallel(const char *value);
+/* Map a file read only and return its text, followed by a zero byte, and its length in bytes. Files that
+   can't be mapped are read into memory instead. The text can go to any parse function, and must be kept
+   until sJSONunmapFile when parsed lazily. Returns NULL if the file can't be opened or read. */
+extern const char *sJSONmapFile(const char *path, size_t *length);
+extern void sJSONunmapFile(const char *text);
+/* Map a file, parse it with the sJSON_File flags and unmap it. On failure sJSONgetErrorPtr is NULL, parse
+   the text of sJSONmapFile to find a syntax error. */
+extern sJSON *sJSONparseFile(const char *path, int flags);
+/* Number of threads sJSONparseMany and sJSONparseParallel use, 0 (the default) for one per core. */
+extern void sJSONsetParseThreads(int threads);
+
+/* Field types for sJSONparseInto: */
+#define sJSON_FieldInt 1         /* int, saturated like sJSONgetIntArray */
+#define sJSON_FieldInt64 2       /* int64_t, saturated like sJSONgetInt64Array */
+#define sJSON_FieldFloat 3       /* float */
+#define sJSON_FieldDouble 4      /* double */
+#define sJSON_FieldBool 5        /* int, 1 for true and 0 for false */
+#define sJSON_FieldString 6      /* char array of size bytes, cut short to fit */
+#define sJSON_FieldObject 7      /* struct described by fields */
+
+/* One member of a struct for sJSONparseInto. A table of them ends with an entry of type 0. */
+typedef struct sJSONField {
+   eastl::FixedMurmurHash key;      /* compile time hash of a literal, like sJSONgetObjectItem takes */
+   int type;
+   size_t offset;                   /* offsetof the member */
+   size_t size;                     /* for sJSON_FieldString */
+   const struct sJSONField *fields; /* for sJSON_FieldObject */
+} sJSONField;
+/* Parse an object straight into the struct at out without building a tree. Values are converted like a cast.
+   Unknown keys and values that don't suit their field are skipped, and members missing from the text are
+   left alone. Returns 0 on a syntax error, with sJSONgetErrorPtr set and out partly written. */
+extern int sJSONparseInto(const char *value, const sJSONField *fields, void *out);
 
 /* Render a sJSON entity to text for transfer/storage. Free the char* when finished. */
 extern char  *sJSONprint(sJSON *item);
@@ -76,18 +211,90 @@ extern char  *sJSONprint(sJSON *item);
 extern char  *sJSONprintUnformatted(sJSON *item);
 /* Delete a sJSON entity and all subentities. */
 extern void   sJSONdelete(sJSON *c);
+extern size_t sJSONmemoryUsage(sJSON *item, sJSONMemory *usage);
+
+/* sJSONWriter flags: */
+#define sJSON_WriteFormatted 1   /* the layout of sJSONprint, otherwise that of sJSONprintUnformatted */
+#define sJSON_WriteDialect 2     /* sJSON syntax: bare identifier keys, "=" and no commas */
+
+/* Write JSON text straight from calls, without building a tree. The output is what sJSONprint or
+   sJSONprintUnformatted would give for the same tree. Pass a buffer to write into it, or NULL to have the
+   writer allocate and grow one. Errors, like running out of room, a key outside an object, a value in an
+   object without its key or a second value at the root, are kept until sJSONwriterFinish, which then returns NULL and frees any buffer it allocated. Otherwise it returns the zero
+   terminated text, which the caller frees if the writer allocated it. Containers nest 64 deep at most. */
+typedef struct sJSONWriter {
+   char *buffer;
+   size_t length, capacity;
+   int flags, owned, failed, depth;
+   uint64_t arrays, started, keyed;
+} sJSONWriter;
+extern void sJSONwriterInit(sJSONWriter *w, char *buffer, size_t capacity, int flags);
+extern char *sJSONwriterFinish(sJSONWriter *w, size_t *length);
+extern void sJSONwriteBeginObject(sJSONWriter *w);
+extern void sJSONwriteEndObject(sJSONWriter *w);
+extern void sJSONwriteBeginArray(sJSONWriter *w);
+extern void sJSONwriteEndArray(sJSONWriter *w);
+extern void sJSONwriteKey(sJSONWriter *w, const char *name);
+extern void sJSONwriteNumber(sJSONWriter *w, double num);
+extern void sJSONwriteString(sJSONWriter *w, const char *string);
+extern void sJSONwriteBool(sJSONWriter *w, int b);
+extern void sJSONwriteNull(sJSONWriter *w);
+
+/* sJSONminify flags: */
+#define sJSON_MinifyStrict 1     /* plain JSON: quoted keys, ":" and commas throughout, the root in braces */
+
+/* Strip the comments and whitespace outside strings from length bytes of sJSON text, keeping a space only
+   where two tokens would run together. With sJSON_MinifyStrict identifier keys are quoted, "=" becomes ":",
+   missing commas are added, trailing ones dropped, and a braceless root gets its braces. Without it the text
+   never gets longer, and out may be in; strict output fits in 2*length+3. Returns the length written to
+   out, which is zero terminated, or 0 if the text is malformed, when sJSONgetErrorPtr points at the problem,
+   or out is too small, when it is NULL. */
+extern size_t sJSONminify(const char *in, size_t length, char *out, size_t capacity, int flags);
 
 /* Returns the number of items in an array (or object). */
 extern uint32_t sJSONgetArraySize(sJSON *array);
 /* Retrieve item number "item" from array "array". Returns NULL if unsuccessful. */
 extern sJSON *sJSONgetArrayItem(sJSON *array,int item);
+/* Copy the numbers of an array into numbers, converted like a cast, up to capacity of them. Numbers outside
+   the range of int or int64_t saturate at its limits and NaN becomes 0. Returns the array size, which may be
+   more than capacity, or -1 if it isn't an array of only numbers. Packed arrays are converted straight from
+   their buffer and stay packed. */
+extern int sJSONgetIntArray(sJSON *array,int *numbers,int capacity);
+extern int sJSONgetInt64Array(sJSON *array,int64_t *numbers,int capacity);
+extern int sJSONgetFloatArray(sJSON *array,float *numbers,int capacity);
+extern int sJSONgetDoubleArray(sJSON *array,double *numbers,int capacity);
 /* Get item "string" from object. Case SENSITIVE! */
 extern sJSON *sJSONgetObjectItem(sJSON *object, eastl::FixedMurmurHash stringHash);
-extern sJSON *sJSONgetObjectItem(sJSON *object, uint32_t stringHash);
+#ifdef EASTL_MURMUR_HASH_64
+/* Get an item by key hash alone, the only lookup left once the keys are stripped. */
+extern sJSON *sJSONgetObjectItem(sJSON *object, eastl::murmur_hash_t stringHash);
+/* Free the key strings of every item below item, keeping their hashes. Lookups keep working but the keys
+   print as "" and JSON Patch paths to them are empty. */
+extern void sJSONstripKeys(sJSON *item);
+#endif
+/* First item of an array or object. Use this instead of ->child to walk a lazily parsed tree. */
+extern sJSON *sJSONgetChild(sJSON *item);
+
+/* Order the children of object, and of every object below it, by key hash and index them so that
+   sJSONgetObjectItem can binary search. The original key order is dropped and printing follows the hash
+   order. Adding, detaching or replacing items keeps the order but removes the index (and sJSON_IsSorted)
+   until the object is sorted again; sJSON_IsReordered stays set to say the key order isn't the source's.
+   Returns 0 on memory failure. */
+extern int sJSONsortObject(sJSON *object);
+
+/* Lookup cache for reading one key from many objects that share a layout, like an array of records.
+   It remembers the position the key was last found at and checks that position first. */
+typedef struct sJSONKeyCache {
+   eastl::FixedMurmurHash key;
+   uint32_t index;
+} sJSONKeyCache;
+extern void sJSONinitKeyCache(sJSONKeyCache *cache, eastl::FixedMurmurHash key);
+extern sJSON *sJSONgetObjectItemCached(sJSON *object, sJSONKeyCache *cache);
 
 
 /* For analysing failed parses. This returns a pointer to the parse error. You'll probably need to look a
-   few chars back to make sense of it. Defined when sJSON_Parse() returns 0. 0 when sJSON_Parse() succeeds. */
+   few chars back to make sense of it. Defined when sJSON_Parse() returns 0. 0 when sJSON_Parse() succeeds.
+   Each thread has its own. */
 extern const char *sJSONgetErrorPtr();
 
 /* These calls create a sJSON item of the appropriate type. */
@@ -105,9 +312,14 @@ extern sJSON *sJSONcreateIntArray(int *numbers,int count);
 extern sJSON *sJSONcreateFloatArray(float *numbers,int count);
 extern sJSON *sJSONcreateDoubleArray(double *numbers,int count);
 extern sJSON *sJSONcreateStringArray(const char **strings,int count);
+/* A packed array of count numbers of an sJSON_Packed kind. It prints without a node per element, and the
+   accessors and sJSONgetChild unpack it into one the first time an element is reached. */
+extern sJSON *sJSONcreatePackedArray(const void *numbers,int count,int kind);
 
 
-/* Append item to the specified array/object. */
+/* Append item to the specified array/object. The add and replace functions take ownership of item: if the
+   container is frozen, or has nothing to replace at which or string, item is deleted. A frozen item is refused
+   and stays with the caller. */
 extern void sJSONaddItemToArray(sJSON *array, sJSON *item);
 extern void	sJSONaddItemToObject(sJSON *object,const char *string,sJSON *item);
 /* Append reference to item to the specified array/object. Use this when you want to add an existing #
@@ -115,6 +327,16 @@ extern void	sJSONaddItemToObject(sJSON *object,const char *string,sJSON *item);
 extern void sJSONaddItemReferenceToArray(sJSON *array, sJSON *item);
 extern void	sJSONaddItemReferenceToObject(sJSON *object,const char *string,sJSON *item);
 
+/* The add functions above walk to the end of the array/object each time. A builder remembers the last child
+   so appends take constant time. Don't change the container any other way while a builder is adding to it. */
+typedef struct sJSONBuilder {
+   sJSON *container;
+   sJSON *last;
+} sJSONBuilder;
+extern void sJSONbuilderInit(sJSONBuilder *builder, sJSON *container);
+extern void sJSONbuilderAdd(sJSONBuilder *builder, sJSON *item);
+extern void sJSONbuilderAddToObject(sJSONBuilder *builder, const char *string, sJSON *item);
+
 /* Remove/Detatch items from Arrays/Objects. */
 extern sJSON *sJSONdetachItemFromArray(sJSON *array,int which);
 extern void   sJSONdeleteItemFromArray(sJSON *array,int which);
@@ -125,6 +347,52 @@ extern void   sJSONdeleteItemFromObject(sJSON *object,const char *string);
 extern void sJSONreplaceItemInArray(sJSON *array,int which,sJSON *newitem);
 extern void sJSONreplaceItemInObject(sJSON *object,const char *string,sJSON *newitem);
 
+/* Change the value of an item in place. */
+extern void sJSONsetNumber(sJSON *item, double num);
+extern void sJSONsetString(sJSON *item, const char *string);
+extern void sJSONsetBool(sJSON *item, int b);
+
+/* Change journal. While a journal is set, changes made with the add, detach, delete, replace and set functions
+   to items of the tree it was created for are recorded, so they can be sent as a delta instead of the whole
+   tree. Delete the journal before the tree. */
+typedef struct sJSONJournal sJSONJournal;
+extern sJSONJournal *sJSONcreateJournal(sJSON *root);
+extern void sJSONdeleteJournal(sJSONJournal *journal);
+extern void sJSONsetJournal(sJSONJournal *journal);
+/* Render the recorded changes as an RFC 6902 JSON Patch, or as a binary delta of *size bytes, and clear them.
+   Free the char* when finished. Returns NULL if recording ran out of memory; send the whole tree instead. */
+extern char *sJSONjournalPrintPatch(sJSONJournal *journal);
+extern char *sJSONjournalPrintBinary(sJSONJournal *journal, uint32_t *size);
+/* Apply the add, remove and replace operations of a JSON Patch or binary delta. Returns 0 if one fails. */
+extern int sJSONapplyPatch(sJSON *root, sJSON *patch);
+extern int sJSONapplyBinaryPatch(sJSON *root, const char *data, uint32_t size);
+
+/* Copy a tree into one compact, read only block that any number of threads can read at once. The original is
+   left as it was. Functions that would change a frozen tree do nothing. Delete only the root, which frees the
+   whole copy; sJSONdelete ignores the other items of a frozen tree. Packed arrays keep their buffer in the copy,
+   for sJSONget...Array and printing, and also get a read only item per number for sJSONgetArrayItem. Returns
+   NULL on memory failure. */
+extern sJSON *sJSONfreeze(sJSON *item);
+
+/* Parse length bytes of zero terminated text through a cache of parsed trees kept in the directory cacheDir.
+   Text seen before, by its murmurHash_x64_128, is loaded from its image in the cache instead of parsed; new
+   text is parsed and its image written for next time. An image is only used if its length, checksum, and the
+   build that wrote it (sJSON layout, key hash and parse options) match, and is rewritten otherwise. The
+   result is frozen as by sJSONfreeze, with keys outside any key table. Returns NULL if the text doesn't parse;
+   a cache that can't be read or written just means parsing. */
+extern sJSON *sJSONparseCached(const char *value, size_t length, const char *cacheDir);
+
+/* Handle to a frozen tree that one thread can swap while others read it. Readers never wait: sJSONacquire
+   returns the current root and keeps it alive until the matching sJSONrelease. sJSONswap publishes a new
+   frozen root, taking ownership of it, and the old one is freed when its last reader releases it. The
+   create and swap functions take only sJSONfreeze results, and return 0 otherwise. */
+typedef struct sJSONHandle sJSONHandle;
+extern sJSONHandle *sJSONcreateHandle(sJSON *frozen);
+extern void sJSONdeleteHandle(sJSONHandle *handle);
+extern sJSON *sJSONacquire(sJSONHandle *handle);
+extern void sJSONrelease(sJSON *frozen);
+extern int sJSONswap(sJSONHandle *handle, sJSON *frozen);
+
 #define sJSONaddNullToObject(object,name)       sJSONaddItemToObject(object, name, sJSONcreateNull())
 #define sJSONaddTrueToObject(object,name)       sJSONaddItemToObject(object, name, sJSONcreateTrue())
 #define sJSONaddFalseToObject(object,name)		sJSONaddItemToObject(object, name, sJSONcreateFalse())